@@ -0,0 +1,258 @@
+// Headless benchmarks of the world subsystem: streaming, meshing, chunk lookup and generation.
+// Results are printed to stdout as one JSON object so runs can be diffed and charted; progress
+// and errors go to stderr.
+//
+//   ForgedFlightBench [--seed N] [--render-distance N] [--frames N] [--only streaming|meshing|lookup|generation]
+
+#include "World/VoxelWorld.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions
+{
+    uint64_t Seed = WorldGenerator::DefaultSeed;
+    int RenderDistance = 8;
+    int Frames = 600;               // Frames of the streaming flight, after the world has settled
+    std::string Only;               // Run a single benchmark
+};
+
+// Frame pacing of the streaming run: the world is told this much time passed each frame, and the
+// loop sleeps out the rest of it so the workers get a realistic share of each frame
+static constexpr double s_FrameTimeMs = 1000.0 / 60.0;
+static constexpr float s_FlightSpeed = 60.0f;       // Blocks per second along +X
+static constexpr float s_FlightAltitude = 40.0f;
+static constexpr int s_MaxSettleFrames = 3000;
+
+// Steady state: shuttle over a fixed stretch with the unloaded chunk cache off, so unloaded chunks
+// go straight back to the pool and nothing is left to grow once warm-up has covered the stretch
+static constexpr float s_SteadySpan = 256.0f;       // Blocks along +X and back
+static constexpr int s_SteadyWarmupFrames = 1024;   // Two round trips at s_FlightSpeed
+
+static bool ParseOptions(int argc, char** argv, BenchOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+            return false;
+        if (std::strcmp(arg, "--seed") == 0)
+            options.Seed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(arg, "--render-distance") == 0)
+            options.RenderDistance = std::max(1, std::atoi(value));
+        else if (std::strcmp(arg, "--frames") == 0)
+            options.Frames = std::max(1, std::atoi(value));
+        else if (std::strcmp(arg, "--only") == 0)
+            options.Only = value;
+        else
+            return false;
+        ++i;
+    }
+    return true;
+}
+
+static bool ShouldRun(const BenchOptions& options, const char* name)
+{
+    return options.Only.empty() || options.Only == name;
+}
+
+// Nearest-rank percentile of sorted samples
+static double Percentile(const std::vector<double>& sorted, double fraction)
+{
+    if (sorted.empty())
+        return 0.0;
+    size_t rank = static_cast<size_t>(fraction * sorted.size() + 0.999999);
+    return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+static bool IsStreamingIdle(const VoxelWorld& world)
+{
+    return world.GetQueueSize() == 0 && world.GetInFlightCount() == 0 && world.GetCompletedCount() == 0 &&
+           world.GetReadyToMeshCount() == 0 && world.GetMeshingCount() == 0 && world.GetDirtyChunkCount() == 0;
+}
+
+// One frame of the game loop without the renderer: update the world and consume its events
+static double RunFrame(VoxelWorld& world, const float3& position, std::vector<ChunkEvent>& events)
+{
+    const Clock::time_point frameStart = Clock::now();
+    world.Update(position, float3(1.0f, 0.0f, 0.0f), s_FrameTimeMs);
+    events.clear();
+    world.DrainChunkEvents(events);
+    const double updateMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+
+    std::this_thread::sleep_until(frameStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(s_FrameTimeMs)));
+    return updateMs;
+}
+
+// Initial load: hover at the origin until nothing is left to stream; returns the frame count
+static int SettleWorld(VoxelWorld& world, std::vector<ChunkEvent>& events)
+{
+    int frames = 0;
+    do
+    {
+        RunFrame(world, float3(0.0f, s_FlightAltitude, 0.0f), events);
+        frames++;
+    } while (!IsStreamingIdle(world) && frames < s_MaxSettleFrames);
+    return frames;
+}
+
+static void RunStreaming(VoxelWorld& world, const BenchOptions& options)
+{
+    std::vector<ChunkEvent> events;
+
+    const Clock::time_point settleStart = Clock::now();
+    const int settleFrames = SettleWorld(world, events);
+    const double settleMs = std::chrono::duration<double, std::milli>(Clock::now() - settleStart).count();
+    const size_t settledChunks = world.GetChunkCount();
+
+    // Flight: every chunk boundary crossing streams a new slab in and an old one out
+    std::vector<double> updateMs;
+    updateMs.reserve(options.Frames);
+    size_t heapAllocations = 0;
+    size_t maxBacklog = 0;
+    const size_t generatedBefore = world.GetGenerationStats().ChunksGenerated;
+    const size_t chunksAllocatedBefore = world.GetAllocationStats().Chunks.ChunksAllocated;
+    for (int frame = 0; frame < options.Frames; ++frame)
+    {
+        const float x = s_FlightSpeed * static_cast<float>(frame * s_FrameTimeMs / 1000.0);
+        updateMs.push_back(RunFrame(world, float3(x, s_FlightAltitude, 0.0f), events));
+        heapAllocations += world.GetAllocationStats().HeapAllocationsLastFrame;
+        maxBacklog = std::max(maxBacklog, world.GetQueueSize() + world.GetInFlightCount());
+    }
+
+    std::vector<double> sorted = updateMs;
+    std::sort(sorted.begin(), sorted.end());
+    const size_t overBudget = std::count_if(updateMs.begin(), updateMs.end(), [](double ms) { return ms > s_FrameTimeMs; });
+    const UnloadedChunkCacheStats cacheStats = world.GetUnloadedCacheStats();
+    const size_t chunksAllocated = world.GetAllocationStats().Chunks.ChunksAllocated - chunksAllocatedBefore;
+    const size_t loadedChunks = world.GetChunkCount();
+    const size_t chunksGenerated = world.GetGenerationStats().ChunksGenerated - generatedBefore;
+
+    const float steadyStartX = s_FlightSpeed * static_cast<float>(options.Frames * s_FrameTimeMs / 1000.0);
+    auto steadyPosition = [steadyStartX](int frame)
+    {
+        const float distance = std::fmod(s_FlightSpeed * static_cast<float>(frame * s_FrameTimeMs / 1000.0), 2.0f * s_SteadySpan);
+        return float3(steadyStartX + (distance < s_SteadySpan ? distance : 2.0f * s_SteadySpan - distance), s_FlightAltitude, 0.0f);
+    };
+    const size_t cacheBudget = world.GetUnloadedCacheBudget();
+    world.SetUnloadedCacheBudget(0);
+    for (int frame = 0; frame < s_SteadyWarmupFrames; ++frame)
+    {
+        RunFrame(world, steadyPosition(frame), events);
+    }
+    size_t steadyAllocations = 0;
+    size_t steadyMaxAllocations = 0;
+    size_t steadyFramesAllocating = 0;
+    for (int frame = s_SteadyWarmupFrames; frame < s_SteadyWarmupFrames + options.Frames; ++frame)
+    {
+        RunFrame(world, steadyPosition(frame), events);
+        const size_t allocations = world.GetAllocationStats().HeapAllocationsLastFrame;
+        steadyAllocations += allocations;
+        steadyMaxAllocations = std::max(steadyMaxAllocations, allocations);
+        steadyFramesAllocating += allocations > 0 ? 1 : 0;
+    }
+    world.SetUnloadedCacheBudget(cacheBudget);
+    if (steadyAllocations > 0)
+        std::fprintf(stderr, "steady state allocated %zu times in %zu of %d frames\n", steadyAllocations, steadyFramesAllocating, options.Frames);
+
+    std::printf("  \"streaming\": {\"settle_frames\": %d, \"settle_ms\": %.1f, \"settled_chunks\": %zu, ", settleFrames, settleMs, settledChunks);
+    std::printf("\"flight_frames\": %d, \"update_ms_p50\": %.3f, \"update_ms_p95\": %.3f, \"update_ms_p99\": %.3f, \"update_ms_max\": %.3f, ",
+                options.Frames, Percentile(sorted, 0.50), Percentile(sorted, 0.95), Percentile(sorted, 0.99), sorted.back());
+    std::printf("\"frames_over_budget\": %zu, \"chunks_generated\": %zu, \"max_backlog\": %zu, \"cancelled_jobs\": %zu, ",
+                overBudget, chunksGenerated, maxBacklog, world.GetCancelledJobCount());
+    // Flight allocations include the unloaded chunk cache filling up; the steady state has none to make
+    std::printf("\"cache_hits\": %zu, \"cache_misses\": %zu, \"heap_allocations\": %zu, \"chunks_allocated\": %zu, \"loaded_chunks\": %zu, ",
+                cacheStats.Hits, cacheStats.Misses, heapAllocations, chunksAllocated, loadedChunks);
+    std::printf("\"steady_frames\": %d, \"steady_heap_allocations\": %zu, \"steady_max_frame_allocations\": %zu, "
+                "\"steady_frames_allocating\": %zu, \"steady_state_allocation_free\": %s},\n",
+                options.Frames, steadyAllocations, steadyMaxAllocations, steadyFramesAllocating, steadyAllocations == 0 ? "true" : "false");
+}
+
+static void RunMeshing(VoxelWorld& world)
+{
+    // Every mode meshes the loaded world's snapshots; Binary must match Greedy quad for quad
+    world.CompareMeshingModes(MeshingMode::Naive, MeshingMode::Greedy);
+    const MesherComparison naiveGreedy = world.GetMesherComparison();
+    world.CompareMeshingModes(MeshingMode::Greedy, MeshingMode::Binary);
+    const MesherComparison greedyBinary = world.GetMesherComparison();
+
+    const double chunks = static_cast<double>(std::max<size_t>(greedyBinary.ChunksCompared, 1));
+    std::printf("  \"meshing\": {\"chunks\": %zu, \"naive_us_per_chunk\": %.2f, \"greedy_us_per_chunk\": %.2f, "
+                "\"binary_us_per_chunk\": %.2f, \"binary_mismatches\": %zu},\n",
+                greedyBinary.ChunksCompared, naiveGreedy.ReferenceTimeMs * 1000.0 / chunks,
+                greedyBinary.ReferenceTimeMs * 1000.0 / chunks, greedyBinary.CandidateTimeMs * 1000.0 / chunks,
+                greedyBinary.Mismatches);
+}
+
+static void RunLookup(VoxelWorld& world)
+{
+    world.BenchmarkChunkLookup();
+    const ChunkLookupBenchmark& result = world.GetChunkLookupBenchmark();
+    std::printf("  \"lookup\": {\"lookups\": %zu, \"hits\": %zu, \"mismatches\": %zu, \"index_ns\": %.2f, \"map_ns\": %.2f},\n",
+                result.Lookups, result.Hits, result.Mismatches, result.IndexNsPerLookup, result.MapNsPerLookup);
+}
+
+static void RunGeneration(VoxelWorld& world)
+{
+    world.BenchmarkGeneration();
+    const GenerationBenchmark& result = world.GetGenerationBenchmark();
+    std::printf("  \"generation\": {\"chunks\": %zu, \"mismatches\": %zu, \"simd_chunks_per_s\": %.1f, \"scalar_chunks_per_s\": %.1f},\n",
+                result.ChunksGenerated, result.Mismatches, result.SimdChunksPerSecond, result.ScalarChunksPerSecond);
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "usage: %s [--seed N] [--render-distance N] [--frames N] [--only streaming|meshing|lookup|generation]\n", argv[0]);
+        return 2;
+    }
+
+    VoxelWorld world(options.Seed);
+    world.SetRenderDistance(options.RenderDistance);
+
+    std::printf("{\n  \"seed\": %llu, \"render_distance\": %d, \"workers\": %zu, \"hardware_threads\": %u,\n",
+                static_cast<unsigned long long>(options.Seed), options.RenderDistance, world.GetWorkerCount(),
+                std::thread::hardware_concurrency());
+
+    // Meshing and lookups use the streamed world as their corpus
+    if (ShouldRun(options, "streaming"))
+    {
+        std::fprintf(stderr, "streaming...\n");
+        RunStreaming(world, options);
+    }
+    else if (ShouldRun(options, "meshing") || ShouldRun(options, "lookup"))
+    {
+        std::fprintf(stderr, "loading world...\n");
+        std::vector<ChunkEvent> events;
+        SettleWorld(world, events);
+    }
+    if (ShouldRun(options, "meshing"))
+    {
+        std::fprintf(stderr, "meshing...\n");
+        RunMeshing(world);
+    }
+    if (ShouldRun(options, "lookup"))
+    {
+        std::fprintf(stderr, "lookup...\n");
+        RunLookup(world);
+    }
+    if (ShouldRun(options, "generation"))
+    {
+        std::fprintf(stderr, "generation...\n");
+        RunGeneration(world);
+    }
+
+    std::printf("  \"chunks_loaded\": %zu\n}\n", world.GetChunkCount());
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+// Zero-initialized, so counting works from the first allocation, before any static constructor runs
+static std::atomic<uint64_t> s_TotalAllocations{0};
+static thread_local uint64_t s_ThreadAllocations = 0;
+
+uint64_t AllocationCounter::GetTotalAllocations()
+{
+    return s_TotalAllocations.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::GetThreadAllocations()
+{
+    return s_ThreadAllocations;
+}
+
+static void CountAllocation()
+{
+    s_ThreadAllocations++;
+    s_TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void* AllocateCounted(std::size_t size, std::size_t alignment)
+{
+    CountAllocation();
+    if (size == 0)
+        size = 1;
+
+    // Same contract as the default operator new: retry through the new handler, throw without one
+    for (;;)
+    {
+#if defined(_MSC_VER)
+        void* memory = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? _aligned_malloc(size, alignment) : std::malloc(size);
+#else
+        void* memory = nullptr;
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            if (posix_memalign(&memory, alignment, size) != 0)
+                memory = nullptr;
+        }
+        else
+        {
+            memory = std::malloc(size);
+        }
+#endif
+        if (memory != nullptr)
+            return memory;
+
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+static void* AllocateCountedNoThrow(std::size_t size, std::size_t alignment) noexcept
+{
+    try
+    {
+        return AllocateCounted(size, alignment);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+static void FreeCounted(void* memory, std::size_t alignment) noexcept
+{
+#if defined(_MSC_VER)
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        _aligned_free(memory);
+    else
+        std::free(memory);
+#else
+    (void)alignment;
+    std::free(memory);
+#endif
+}
+
+// Every form of delete is replaced too, so none of them falls through to the library version,
+// which might not pair with this allocator
+void* operator new(std::size_t size) { return AllocateCounted(size, 0); }
+void* operator new[](std::size_t size) { return AllocateCounted(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return AllocateCountedNoThrow(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return AllocateCountedNoThrow(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateCounted(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateCounted(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateCountedNoThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateCountedNoThrow(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* memory) noexcept { FreeCounted(memory, 0); }
+void operator delete[](void* memory) noexcept { FreeCounted(memory, 0); }
+void operator delete(void* memory, std::align_val_t alignment) noexcept { FreeCounted(memory, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { FreeCounted(memory, static_cast<std::size_t>(alignment)); }
+void operator delete(void* memory, std::size_t) noexcept { FreeCounted(memory, 0); }
+void operator delete[](void* memory, std::size_t) noexcept { FreeCounted(memory, 0); }
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept { FreeCounted(memory, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* memory, std::size_t, std::align_val_t alignment) noexcept { FreeCounted(memory, static_cast<std::size_t>(alignment)); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { FreeCounted(memory, 0); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { FreeCounted(memory, 0); }
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { FreeCounted(memory, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { FreeCounted(memory, static_cast<std::size_t>(alignment)); }
@@ -0,0 +1,18 @@
+#pragma once
+
+// Heap allocation counter. AllocationCounter.cpp replaces the global operator new and delete, so
+// every allocation made through new (which includes the standard containers) is counted, on
+// every thread, with no per-call-site bookkeeping. Each thread also keeps its own count, so a
+// subsystem can attribute allocations to the work it ran on its threads.
+
+#include <cstdint>
+
+class AllocationCounter
+{
+public:
+    // Allocations made by every thread since startup
+    static uint64_t GetTotalAllocations();
+
+    // Allocations made by the calling thread since it started
+    static uint64_t GetThreadAllocations();
+};
@@ -1,4 +1,5 @@
 #include "ForgedFlightApp.h"
+#include "Profiler.h"
 #include "../Rendering/Camera.h"
 #include "../Rendering/AdvancedRenderer.h"
 #include "../World/VoxelWorld.h"
@@ -20,6 +21,8 @@
 #include "Common/interface/StringDataBlobImpl.hpp"
 #include "Graphics/GraphicsTools/interface/MapHelper.hpp"
 
+#include <algorithm>
+#include <ctime>
 #include <string>
 #include <vector>
 
@@ -45,6 +48,7 @@ void ForgedFlightApp::Initialize(const NativeAppInitAttrib& InitAttrib)
         freopen_s(&pCout, "CONOUT$", "w", stdout);
         
         std::cout << "Starting ForgedFlightApp::Initialize" << std::endl;
+        PROFILE_THREAD("Main");
         
         m_WindowWidth = 1280;
         m_WindowHeight = 720;
@@ -187,6 +191,9 @@ void ForgedFlightApp::CreateCubePipelineState()
     m_pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(nullptr, &pShaderSourceFactory);
 
     // Vertex shader for voxel cubes
+    // Chunk vertices are packed into two uints: chunk-local position (5 bits per axis)
+    // and face index in the first, block type in the second. Normals and UVs are derived here.
+    // The chunk origin is a per-instance attribute, one instance per drawn chunk.
     const char* VSSource = R"(
         cbuffer Constants
         {
@@ -195,9 +202,8 @@ void ForgedFlightApp::CreateCubePipelineState()
 
         struct VSInput
         {
-            float3 Pos : ATTRIB0;
-            float3 Normal : ATTRIB1;
-            float2 UV : ATTRIB2;
+            uint2 Packed : ATTRIB0;
+            float4 ChunkOrigin : ATTRIB1;
         };
 
         struct PSInput
@@ -208,12 +214,31 @@ void ForgedFlightApp::CreateCubePipelineState()
             float3 WorldPos : WORLD_POS;
         };
 
+        // Face order matches BlockFace: Top, Bottom, Right, Left, Front, Back
+        static const float3 FaceNormals[6] =
+        {
+            float3(0, 1, 0), float3(0, -1, 0),
+            float3(1, 0, 0), float3(-1, 0, 0),
+            float3(0, 0, 1), float3(0, 0, -1)
+        };
+
         void main(in VSInput VSIn, out PSInput PSOut)
         {
-            PSOut.WorldPos = VSIn.Pos;
-            PSOut.Pos = mul(ViewProjMatrix, float4(VSIn.Pos, 1.0));
-            PSOut.Normal = VSIn.Normal;
-            PSOut.UV = VSIn.UV;
+            float3 localPos = float3(VSIn.Packed.x & 31u, (VSIn.Packed.x >> 5) & 31u, (VSIn.Packed.x >> 10) & 31u);
+            uint face = (VSIn.Packed.x >> 15) & 7u;
+            float3 worldPos = VSIn.ChunkOrigin.xyz + localPos;
+
+            PSOut.WorldPos = worldPos;
+            PSOut.Pos = mul(ViewProjMatrix, float4(worldPos, 1.0));
+            PSOut.Normal = FaceNormals[face];
+
+            // Planar UVs in block units (one repeat per block)
+            if (face < 2)
+                PSOut.UV = worldPos.xz;
+            else if (face < 4)
+                PSOut.UV = worldPos.yz;
+            else
+                PSOut.UV = worldPos.yx;
         }
     )";
 
@@ -239,17 +264,18 @@ void ForgedFlightApp::CreateCubePipelineState()
             float NdotL = max(dot(PSIn.Normal, lightDir), 0.2);
             
             // Use UV coordinates as RGB color
-            // UV coordinates range from 0-1, perfect for RGB values
-            float3 baseColor = float3(PSIn.UV.x, PSIn.UV.y, 0.5);
+            // UVs repeat once per block (merged quads span several), so wrap them to 0-1
+            float2 uv = frac(PSIn.UV);
+            float3 baseColor = float3(uv.x, uv.y, 0.5);
             
             // Add some variation based on the normal to distinguish faces
             if (abs(PSIn.Normal.x) > 0.5) // Left/Right faces
             {
-                baseColor = float3(PSIn.UV.y, 0.5, PSIn.UV.x);
+                baseColor = float3(uv.y, 0.5, uv.x);
             }
             else if (abs(PSIn.Normal.z) > 0.5) // Front/Back faces  
             {
-                baseColor = float3(0.5, PSIn.UV.x, PSIn.UV.y);
+                baseColor = float3(0.5, uv.x, uv.y);
             }
             // Top/Bottom faces use the original UV mapping
             
@@ -281,9 +307,8 @@ void ForgedFlightApp::CreateCubePipelineState()
     // Define vertex layout
     LayoutElement LayoutElems[] =
     {
-        LayoutElement{0, 0, 3, VT_FLOAT32, False}, // Position
-        LayoutElement{1, 0, 3, VT_FLOAT32, False}, // Normal
-        LayoutElement{2, 0, 2, VT_FLOAT32, False}  // UV
+        LayoutElement{0, 0, 2, VT_UINT32, False},                                     // Packed position/face + attributes
+        LayoutElement{1, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE}  // Chunk origin
     };
 
     // Create pipeline state
@@ -426,13 +451,16 @@ void ForgedFlightApp::InitializeVoxelWorld()
 
 void ForgedFlightApp::Update(double CurrTime, double ElapsedTime)
 {
+    PROFILE_FRAME();
+    m_LastFrameTime = CurrTime;
+    
     // Update camera based on input
     UpdateCamera(ElapsedTime);
     // Update voxel world and chunk manager (re-enabled for chunk system testing)
     // Update voxel world
     if (m_pVoxelWorld)
     {
-        m_pVoxelWorld->Update(m_pCamera->GetPosition());
+        m_pVoxelWorld->Update(m_pCamera->GetPosition(), m_pCamera->GetForward(), ElapsedTime * 1000.0);
     }
     
     // Update chunk manager
@@ -579,6 +607,11 @@ void ForgedFlightApp::OnKeyDown(UINT8 key)
         }
     }
 
+#ifdef FORGED_FLIGHT_PROFILER
+    if (key == VK_F9)
+        StartTraceCapture();
+#endif
+
     // Only handle camera movement if ImGui doesn't want keyboard input
     ImGuiIO& io = ImGui::GetIO();
     if (!io.WantCaptureKeyboard)
@@ -806,7 +839,9 @@ void ForgedFlightApp::RenderImGuiDebugWindow()
         // Quick position presets
         if (ImGui::Button("Ground Level"))
         {
-            m_pCamera->SetPosition(float3(0.0f, 2.0f, 0.0f));
+            // Stand two blocks above the terrain (or the sea) under the origin
+            float groundY = m_pVoxelWorld ? static_cast<float>(std::max(m_pVoxelWorld->GetSurfaceHeight(0, 0), WorldGenerator::SeaLevel)) + 1.0f : 0.0f;
+            m_pCamera->SetPosition(float3(0.0f, groundY + 2.0f, 0.0f));
         }
         
         ImGui::Separator();
@@ -829,8 +864,37 @@ void ForgedFlightApp::RenderImGuiDebugWindow()
                 m_pVoxelWorld->SetRenderDistance(renderDistance);
             }
             
+            int verticalDistance = m_pVoxelWorld->GetVerticalRenderDistance();
+            if (ImGui::SliderInt("Vertical Distance (Chunks)", &verticalDistance, 1, 32))
+            {
+                m_pVoxelWorld->SetVerticalRenderDistance(verticalDistance);
+            }
+            
+            static const char* streamingShapeNames[] = { "Ellipsoid", "Cylinder" };
+            int streamingShape = static_cast<int>(m_pVoxelWorld->GetStreamingShape());
+            if (ImGui::Combo("Streaming Shape", &streamingShape, streamingShapeNames, IM_ARRAYSIZE(streamingShapeNames)))
+            {
+                m_pVoxelWorld->SetStreamingShape(static_cast<StreamingShape>(streamingShape));
+            }
+            
+            bool surfaceBandBias = m_pVoxelWorld->GetSurfaceBandBias();
+            if (ImGui::Checkbox("Surface Band Bias", &surfaceBandBias))
+            {
+                m_pVoxelWorld->SetSurfaceBandBias(surfaceBandBias);
+            }
+            
+            bool predictivePrefetch = m_pVoxelWorld->GetPredictivePrefetch();
+            if (ImGui::Checkbox("Predictive Prefetch", &predictivePrefetch))
+            {
+                m_pVoxelWorld->SetPredictivePrefetch(predictivePrefetch);
+            }
+            const float3& velocity = m_pVoxelWorld->GetPlayerVelocity();
+            const float3& prefetchOffset = m_pVoxelWorld->GetPrefetchOffset();
+            ImGui::Text("Velocity: (%.1f, %.1f, %.1f) blocks/s, prefetch ahead: (%.1f, %.1f, %.1f) chunks",
+                        velocity.x, velocity.y, velocity.z, prefetchOffset.x, prefetchOffset.y, prefetchOffset.z);
+            
             // Enhanced chunk info with performance warnings
-            int totalPotentialChunks = (2 * renderDistance + 1) * (2 * renderDistance + 1) * (2 * renderDistance + 1);
+            int totalPotentialChunks = static_cast<int>(m_pVoxelWorld->GetStreamingVolumeSize());
             ImGui::Text("Max chunks: %d", totalPotentialChunks);
             
             // Color-code based on performance impact
@@ -846,11 +910,99 @@ void ForgedFlightApp::RenderImGuiDebugWindow()
             
             // Show actual loaded chunks and queue status
             ImGui::Text("Loaded chunks: %zu", m_pVoxelWorld->GetChunkCount());
+            ChunkAllocationStats allocationStats = m_pVoxelWorld->GetAllocationStats();
+            ImGui::Text("Streaming heap allocations last frame: %zu", allocationStats.HeapAllocationsLastFrame);
+            ImGui::Text("  Chunks: %zu allocated, %zu reused, %zu pooled", allocationStats.Chunks.ChunksAllocated,
+                        allocationStats.Chunks.ChunksReused, allocationStats.Chunks.ChunksPooled);
+            ImGui::Text("  Voxel slab: %zu pages (%.2f MB), %zu blocks in use, %zu served",
+                        allocationStats.Voxels.PageAllocations, allocationStats.Voxels.BytesReserved / (1024.0 * 1024.0),
+                        allocationStats.Voxels.BlocksInUse, allocationStats.Voxels.BlocksServed);
+            ImGui::Text("  Mesh buffers: %zu allocated, %zu reused, %zu pooled (%.2f MB)", allocationStats.MeshBuffers.BuffersAllocated,
+                        allocationStats.MeshBuffers.BuffersReused, allocationStats.MeshBuffers.BuffersPooled,
+                        allocationStats.MeshBuffers.PooledBytes / (1024.0 * 1024.0));
+            if (ImGui::Button("Benchmark Chunk Lookup")) {
+                m_pVoxelWorld->BenchmarkChunkLookup();
+            }
+            const ChunkLookupBenchmark& lookupBenchmark = m_pVoxelWorld->GetChunkLookupBenchmark();
+            if (lookupBenchmark.Lookups > 0) {
+                ImGui::Text("%zu lookups (%zu hits), %zu mismatches: index %.1f ns / unordered_map %.1f ns",
+                            lookupBenchmark.Lookups, lookupBenchmark.Hits, lookupBenchmark.Mismatches,
+                            lookupBenchmark.IndexNsPerLookup, lookupBenchmark.MapNsPerLookup);
+            }
             ImGui::Text("Generation queue: %zu", m_pVoxelWorld->GetQueueSize());
+            ImGui::Text("On workers: %zu chunks, %zu meshes (%zu threads), stale jobs cancelled: %zu", m_pVoxelWorld->GetInFlightCount(),
+                        m_pVoxelWorld->GetMeshingCount(), m_pVoxelWorld->GetWorkerCount(), m_pVoxelWorld->GetCancelledJobCount());
             ImGui::Text("Deletion queue: %zu", m_pVoxelWorld->GetDeletionQueueSize());
             
+            // Main-thread streaming budget: how much of it was used and how long each queue takes to drain
+            StreamingBudget& streamingBudget = m_pVoxelWorld->GetStreamingBudget();
+            float targetFrameTime = static_cast<float>(streamingBudget.GetTargetFrameTime());
+            if (ImGui::SliderFloat("Target Frame Time (ms)", &targetFrameTime, 4.0f, 33.3f, "%.1f"))
+            {
+                streamingBudget.SetTargetFrameTime(targetFrameTime);
+            }
+            ImGui::Text("Streaming budget: %.2f / %.2f ms", streamingBudget.GetUsedMsLastFrame(), streamingBudget.GetBudgetMs());
+            
+            static const char* streamingOpNames[] = { "Integrate", "Mesh", "Upload", "Unload" };
+            const size_t pendingOps[] = {
+                m_pVoxelWorld->GetCompletedCount() + m_pVoxelWorld->GetInFlightCount() + m_pVoxelWorld->GetQueueSize(),
+                m_pVoxelWorld->GetReadyToMeshCount() + m_pVoxelWorld->GetMeshingCount(),
+                m_pChunkManager ? m_pChunkManager->GetPendingEventCount() : 0,
+                m_pVoxelWorld->GetDeletionQueueSize()
+            };
+            for (int op = 0; op < static_cast<int>(StreamingOp::Count); ++op)
+            {
+                StreamingOp streamingOp = static_cast<StreamingOp>(op);
+                ImGui::Text("  %-9s %zu/frame, %.3f ms each, %zu pending",
+                            streamingOpNames[op], streamingBudget.GetOpsLastFrame(streamingOp),
+                            streamingBudget.GetAverageCostMs(streamingOp), pendingOps[op]);
+                ImGui::SameLine();
+                double eta = streamingBudget.GetDrainEta(streamingOp, pendingOps[op]);
+                if (eta < 0.0)
+                    ImGui::Text("(stalled)");
+                else
+                    ImGui::Text("(ETA %.1f s)", eta);
+            }
+            
+            // Terrain generation throughput, per core
+            const WorldGenerator& generator = m_pVoxelWorld->GetGenerator();
+            const GenerationStats& generationStats = m_pVoxelWorld->GetGenerationStats();
+            ImGui::Text("Seed: %016llx, worldgen v%u.%u.%u (%s noise)", static_cast<unsigned long long>(generator.GetSeed()),
+                        WorldGenerator::Version.Major, WorldGenerator::Version.Minor, WorldGenerator::Version.Patch,
+                        Noise::GetSimdKernelName());
+            if (generationStats.TotalGenerationTimeMs > 0.0) {
+                ImGui::Text("Workers: %.0f chunks/s per core (avg %.3f ms/chunk)",
+                            generationStats.ChunksGenerated * 1000.0 / generationStats.TotalGenerationTimeMs,
+                            generationStats.TotalGenerationTimeMs / generationStats.ChunksGenerated);
+            }
+            TerrainColumnCacheStats columnStats = m_pVoxelWorld->GetColumnCacheStats();
+            size_t columnLookups = columnStats.Hits + columnStats.Misses;
+            ImGui::Text("Column Cache: %zu columns, %.2f MB, %.1f%% hits, %zu evicted",
+                        columnStats.Columns, columnStats.MemoryBytes / (1024.0 * 1024.0),
+                        columnLookups > 0 ? columnStats.Hits * 100.0 / columnLookups : 0.0, columnStats.Evictions);
+            
+            // Recently unloaded chunks kept for a quick return
+            int unloadedCacheMB = static_cast<int>(m_pVoxelWorld->GetUnloadedCacheBudget() / (1024 * 1024));
+            if (ImGui::SliderInt("Unload Cache (MB)", &unloadedCacheMB, 0, 512))
+            {
+                m_pVoxelWorld->SetUnloadedCacheBudget(static_cast<size_t>(unloadedCacheMB) * 1024 * 1024);
+            }
+            UnloadedChunkCacheStats unloadedStats = m_pVoxelWorld->GetUnloadedCacheStats();
+            ImGui::Text("Unload Cache: %zu chunks, %.2f MB, %zu hits / %zu misses, %zu evicted",
+                        unloadedStats.Chunks, unloadedStats.MemoryBytes / (1024.0 * 1024.0),
+                        unloadedStats.Hits, unloadedStats.Misses, unloadedStats.Evictions);
+            if (ImGui::Button("Benchmark Generation")) {
+                m_pVoxelWorld->BenchmarkGeneration();
+            }
+            const GenerationBenchmark& benchmark = m_pVoxelWorld->GetGenerationBenchmark();
+            if (benchmark.ChunksGenerated > 0) {
+                ImGui::Text("%zu chunks, %zu mismatches: %s %.0f / Scalar %.0f chunks/s per core",
+                            benchmark.ChunksGenerated, benchmark.Mismatches, Noise::GetSimdKernelName(),
+                            benchmark.SimdChunksPerSecond, benchmark.ScalarChunksPerSecond);
+            }
+            
             // Combined queue status indicator
-            size_t totalQueueSize = m_pVoxelWorld->GetQueueSize() + m_pVoxelWorld->GetDeletionQueueSize();
+            size_t totalQueueSize = m_pVoxelWorld->GetQueueSize() + m_pVoxelWorld->GetInFlightCount() + m_pVoxelWorld->GetDeletionQueueSize();
             if (totalQueueSize > 15) {
                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.3f, 1.0f));
                 ImGui::Text("⚠ High queue activity");
@@ -864,7 +1016,7 @@ void ForgedFlightApp::RenderImGuiDebugWindow()
             }
             
             // Individual queue status
-            if (m_pVoxelWorld->GetQueueSize() > 0) {
+            if (m_pVoxelWorld->GetQueueSize() + m_pVoxelWorld->GetInFlightCount() > 0) {
                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.8f, 1.0f, 1.0f));
                 ImGui::Text("  🔄 Generating chunks...");
                 ImGui::PopStyleColor();
@@ -903,6 +1055,20 @@ void ForgedFlightApp::RenderImGuiDebugWindow()
         ImGui::Text("FPS: %.1f", m_PerformanceMetrics.fps);
         ImGui::PopStyleColor();
         
+        if (m_pVoxelWorld) {
+            const GenerationStats& generationStats = m_pVoxelWorld->GetGenerationStats();
+            if (generationStats.ChunksGenerated > 0) {
+                m_PerformanceMetrics.chunkLoadTime = static_cast<float>(generationStats.TotalGenerationTimeMs / generationStats.ChunksGenerated);
+            }
+            ImGui::Text("Chunk Generation: %.2f ms avg", m_PerformanceMetrics.chunkLoadTime);
+        }
+        
+#ifdef FORGED_FLIGHT_PROFILER
+        ImGui::Separator();
+        ImGui::Text("=== FRAME PROFILER ===");
+        RenderProfilerTimeline();
+#endif
+        
         // Rendering statistics
         ImGui::Separator();
         ImGui::Text("=== RENDERING STATS ===");
@@ -911,9 +1077,19 @@ void ForgedFlightApp::RenderImGuiDebugWindow()
         size_t totalVertices = 0;
         size_t totalIndices = 0;
         size_t totalFaces = 0;
+        size_t totalBlockMemory = 0;
+        size_t chunkCount = 0;
+        size_t uniformAirChunks = 0;
+        size_t uniformSolidChunks = 0;
         if (m_pVoxelWorld) {
             const auto& loadedChunks = m_pVoxelWorld->GetLoadedChunks();
             for (const auto& [chunkKey, chunk] : loadedChunks) {
+                if (chunk) {
+                    totalBlockMemory += chunk->GetBlockMemoryUsage();
+                    chunkCount++;
+                    if (chunk->GetContents() == ChunkContents::UniformAir) uniformAirChunks++;
+                    else if (chunk->GetContents() == ChunkContents::UniformSolid) uniformSolidChunks++;
+                }
                 if (chunk && chunk->IsMeshBuilt()) {
                     totalVertices += chunk->GetVertexCount();
                     totalIndices += chunk->GetIndexCount();
@@ -923,7 +1099,93 @@ void ForgedFlightApp::RenderImGuiDebugWindow()
         }
         
         ImGui::Text("Total Vertices: %zu", totalVertices);
+        ImGui::Text("Total Indices: %zu", totalIndices);
         ImGui::Text("Total Faces: %zu", totalFaces);
+        
+        // Frustum culling results from the last frame
+        if (m_pChunkManager)
+        {
+            bool frustumCulling = m_pChunkManager->IsFrustumCullingEnabled();
+            if (ImGui::Checkbox("Frustum Culling", &frustumCulling))
+            {
+                m_pChunkManager->SetFrustumCullingEnabled(frustumCulling);
+            }
+            const ChunkCullingStats& cullingStats = m_pChunkManager->GetCullingStats();
+            ImGui::Text("Chunks Visible: %zu / Culled: %zu", cullingStats.VisibleChunks, cullingStats.CulledChunks);
+            ImGui::Text("Cull Time: %.3f ms", cullingStats.CullTimeMs);
+            
+            // Draw submission: base-vertex draws, or one multi-draw indirect per pool page
+            if (m_pChunkManager->IsMultiDrawIndirectSupported())
+            {
+                bool multiDrawIndirect = m_pChunkManager->IsMultiDrawIndirectEnabled();
+                if (ImGui::Checkbox("Multi-Draw Indirect", &multiDrawIndirect))
+                {
+                    m_pChunkManager->SetMultiDrawIndirectEnabled(multiDrawIndirect);
+                }
+            }
+            const ChunkDrawStats& drawStats = m_pChunkManager->GetDrawStats();
+            ImGui::Text("Draw Calls: %zu, Buffer Binds: %zu (%s)", drawStats.DrawCalls, drawStats.VertexBufferBinds,
+                        drawStats.MultiDrawIndirect ? "indirect" : "base vertex");
+            
+            // Chunk vertex pool occupancy
+            GeometryPoolStats poolStats = m_pChunkManager->GetGeometryPoolStats();
+            float occupancy = poolStats.CapacityBytes > 0 ? static_cast<float>(poolStats.UsedBytes) / static_cast<float>(poolStats.CapacityBytes) : 0.0f;
+            ImGui::Text("Vertex Pool: %.2f / %.2f MB in %zu pages (%.1f%%)",
+                        poolStats.UsedBytes / (1024.0 * 1024.0), poolStats.CapacityBytes / (1024.0 * 1024.0),
+                        poolStats.PageCount, occupancy * 100.0f);
+            ImGui::Text("Pool Meshes: %zu, Holes: %zu, Fragmentation: %.1f%%",
+                        poolStats.AllocationCount, poolStats.FreeRangeCount, poolStats.Fragmentation * 100.0f);
+            ImGui::Text("Pool Compactions: %zu", poolStats.CompactionCount);
+            
+            // Chunk lifecycle: per-frame work follows the number of changes
+            const ChunkLifecycleStats& lifecycleStats = m_pChunkManager->GetLifecycleStats();
+            ImGui::Text("Chunk Events: %zu (uploads: %zu), Dirty: %zu",
+                        lifecycleStats.EventsLastFrame, lifecycleStats.UploadsLastFrame,
+                        m_pVoxelWorld ? m_pVoxelWorld->GetDirtyChunkCount() : 0);
+            ImGui::Text("Unloaded: %zu, Stale Uploads Skipped: %zu", lifecycleStats.Unloads, lifecycleStats.StaleEventsSkipped);
+        }
+        
+        // Block storage memory (palette-compressed vs. one byte per voxel)
+        size_t denseBlockMemory = chunkCount * CHUNK_VOLUME * sizeof(Block);
+        ImGui::Text("Block Memory: %.2f MB (dense: %.2f MB)",
+                    totalBlockMemory / (1024.0 * 1024.0), denseBlockMemory / (1024.0 * 1024.0));
+        ImGui::Text("Block Bytes/Chunk: %zu (dense: %zu)",
+                    chunkCount > 0 ? totalBlockMemory / chunkCount : 0, CHUNK_VOLUME * sizeof(Block));
+        ImGui::Text("Chunks: %zu air / %zu solid / %zu mixed",
+                    uniformAirChunks, uniformSolidChunks, chunkCount - uniformAirChunks - uniformSolidChunks);
+        
+        // Meshing mode selection and per-mode build statistics
+        if (m_pVoxelWorld) {
+            static const char* meshingModeNames[] = { "Naive", "Greedy", "Binary" };
+            int meshingMode = static_cast<int>(m_pVoxelWorld->GetMeshingMode());
+            if (ImGui::Combo("Meshing Mode", &meshingMode, meshingModeNames, IM_ARRAYSIZE(meshingModeNames))) {
+                m_pVoxelWorld->SetMeshingMode(static_cast<MeshingMode>(meshingMode));
+            }
+            
+            for (int mode = 0; mode < static_cast<int>(MeshingMode::Count); ++mode) {
+                const MeshingStats& stats = m_pVoxelWorld->GetMeshingStats(static_cast<MeshingMode>(mode));
+                size_t meshes = stats.MeshesBuilt > 0 ? stats.MeshesBuilt : 1;
+                ImGui::Text("%s: %zu meshes, avg %.3f ms (last %.3f ms)", meshingModeNames[mode],
+                            stats.MeshesBuilt, stats.TotalBuildTimeMs / meshes, stats.LastBuildTimeMs);
+                ImGui::Text("  avg %zu verts / %zu indices per mesh",
+                            stats.VerticesEmitted / meshes, stats.IndicesEmitted / meshes);
+            }
+            if (ImGui::Button("Reset Meshing Stats")) {
+                m_pVoxelWorld->ResetMeshingStats();
+            }
+            
+            // Binary must reproduce Greedy exactly; re-mesh the loaded chunks with both and compare
+            if (ImGui::Button("Verify Binary vs Greedy")) {
+                m_pVoxelWorld->CompareMeshingModes(MeshingMode::Greedy, MeshingMode::Binary);
+            }
+            const MesherComparison& comparison = m_pVoxelWorld->GetMesherComparison();
+            if (comparison.ChunksCompared > 0) {
+                ImGui::Text("%zu chunks, %zu mismatches, Greedy %.2f ms / Binary %.2f ms",
+                            comparison.ChunksCompared, comparison.Mismatches,
+                            comparison.ReferenceTimeMs, comparison.CandidateTimeMs);
+            }
+        }
+        
         ImGui::Text("Back Face Culling: ENABLED");
         ImGui::Text("Winding Order: Counter-Clockwise");
         ImGui::Text("GPU Culling: Active");
@@ -958,4 +1220,106 @@ void ForgedFlightApp::RenderImGuiDebugWindow()
     
     // Render ImGui
     m_pImGuiImpl->Render(m_pImmediateContext);
-}
\ No newline at end of file
+}
+
+#ifdef FORGED_FLIGHT_PROFILER
+void ForgedFlightApp::RenderProfilerTimeline()
+{
+    Profiler& profiler = Profiler::Get();
+    bool paused = profiler.IsPaused();
+    if (ImGui::Checkbox("Pause Timeline", &paused)) {
+        profiler.SetPaused(paused);
+    }
+    
+    const ProfileFrame& frame = profiler.GetLastFrame();
+    const std::vector<std::string> threadNames = profiler.GetThreadNames();
+    const double frameNs = static_cast<double>(std::max<int64_t>(frame.EndNs - frame.StartNs, 1));
+    ImGui::Text("Frame: %.2f ms, %zu scopes, %zu events dropped", frameNs / 1000000.0, frame.Events.size(), profiler.GetDroppedEvents());
+    
+    // One lane per thread that ran a scope this frame, tall enough for its deepest nesting
+    std::vector<int> laneDepth(threadNames.size(), -1);
+    for (const ProfileEvent& event : frame.Events) {
+        laneDepth[event.Thread] = std::max<int>(laneDepth[event.Thread], event.Depth);
+    }
+    std::vector<float> laneOffset(threadNames.size(), 0.0f);
+    const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    const float labelWidth = 110.0f;
+    float totalHeight = 0.0f;
+    for (size_t thread = 0; thread < threadNames.size(); ++thread) {
+        laneOffset[thread] = totalHeight;
+        if (laneDepth[thread] >= 0) {
+            totalHeight += (laneDepth[thread] + 1) * rowHeight + 2.0f;
+        }
+    }
+    
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float timelineWidth = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 50.0f);
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    const ProfileEvent* hovered = nullptr;
+    
+    for (size_t thread = 0; thread < threadNames.size(); ++thread) {
+        if (laneDepth[thread] >= 0) {
+            drawList->AddText(ImVec2(origin.x, origin.y + laneOffset[thread] + 2.0f), IM_COL32(200, 200, 200, 255), threadNames[thread].c_str());
+        }
+    }
+    for (const ProfileEvent& event : frame.Events) {
+        // Worker scopes can start in an earlier frame; clip them to this one
+        const double start = std::max<double>(event.StartNs - frame.StartNs, 0.0) / frameNs;
+        const double end = std::min<double>(event.EndNs - frame.StartNs, frameNs) / frameNs;
+        const float x0 = origin.x + labelWidth + static_cast<float>(start) * timelineWidth;
+        const float x1 = std::max(origin.x + labelWidth + static_cast<float>(end) * timelineWidth, x0 + 1.0f);
+        const float y0 = origin.y + laneOffset[event.Thread] + event.Depth * rowHeight;
+        const float y1 = y0 + rowHeight - 1.0f;
+        
+        // Color by name so a scope keeps its color from frame to frame
+        uint32_t nameHash = 2166136261u;
+        for (const char* c = event.Name; *c != '\0'; ++c) {
+            nameHash = (nameHash ^ static_cast<uint8_t>(*c)) * 16777619u;
+        }
+        const ImU32 color = ImColor::HSV((nameHash % 360) / 360.0f, 0.55f, 0.75f);
+        drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), color);
+        if (x1 - x0 > ImGui::CalcTextSize(event.Name).x + 4.0f) {
+            drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(255, 255, 255, 255), event.Name);
+        }
+        if (mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1) {
+            hovered = &event;
+        }
+    }
+    ImGui::Dummy(ImVec2(labelWidth + timelineWidth, std::max(totalHeight, rowHeight)));
+    if (hovered != nullptr && ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("%s\n%.3f ms", hovered->Name, (hovered->EndNs - hovered->StartNs) / 1000000.0);
+    }
+    
+    // Trace capture for offline analysis
+    ImGui::SliderInt("Capture Frames", &m_TraceCaptureFrames, 10, 2000);
+    if (profiler.IsCapturing()) {
+        ImGui::Text("Capturing trace: %zu frames left, %zu events", profiler.GetCaptureFramesLeft(), profiler.GetCapturedEventCount());
+    } else {
+        if (ImGui::Button("Capture Trace (F9)")) {
+            StartTraceCapture();
+        }
+        if (!profiler.GetCapturePath().empty()) {
+            ImGui::SameLine();
+            ImGui::Text(profiler.WasCaptureWritten() ? "Wrote %s" : "Failed to write %s", profiler.GetCapturePath().c_str());
+        }
+    }
+    
+    // Rolling percentiles per scope
+    ImGui::Text("%-36s %6s %8s %8s %8s %8s", "Scope", "Calls", "Total", "p50", "p95", "p99");
+    for (const ProfileScopeStats& stats : profiler.GetScopeStats()) {
+        ImGui::Text("%-36s %6zu %8.3f %8.3f %8.3f %8.3f", stats.Name, stats.CallsLastFrame, stats.TotalMsLastFrame,
+                    stats.P50Ms, stats.P95Ms, stats.P99Ms);
+    }
+}
+
+void ForgedFlightApp::StartTraceCapture()
+{
+    char fileName[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(fileName, sizeof(fileName), "ForgedFlight_%Y%m%d_%H%M%S.trace.json", std::localtime(&now));
+    if (Profiler::Get().StartCapture(static_cast<size_t>(m_TraceCaptureFrames), fileName)) {
+        std::cout << "Capturing " << m_TraceCaptureFrames << " frames to " << fileName << std::endl;
+    }
+}
+#endif
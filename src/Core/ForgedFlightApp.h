@@ -74,6 +74,10 @@ private:
     // Debug UI
     void InitializeImGui();
     void RenderImGuiDebugWindow();
+#ifdef FORGED_FLIGHT_PROFILER
+    void RenderProfilerTimeline();
+    void StartTraceCapture();
+#endif
 
     // Diligent Engine core objects
     RefCntAutoPtr<IRenderDevice>        m_pDevice;
@@ -116,6 +120,11 @@ private:
     // Timing
     double                              m_LastFrameTime = 0.0;
 
+#ifdef FORGED_FLIGHT_PROFILER
+    // Frames recorded by a trace capture (F9)
+    int                                 m_TraceCaptureFrames = 300;
+#endif
+
     // Window properties
     unsigned int                        m_WindowWidth = 1280;
     unsigned int                        m_WindowHeight = 720;
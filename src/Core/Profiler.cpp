@@ -0,0 +1,300 @@
+#include "Profiler.h"
+
+#ifdef FORGED_FLIGHT_PROFILER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// Single producer (the owning thread), single consumer (the main thread in BeginFrame)
+struct ProfilerThreadBuffer
+{
+    ProfileEvent Events[Profiler::RingCapacity];
+    std::atomic<uint64_t> WriteIndex{0};
+    uint64_t ReadIndex = 0;     // Consumer only
+    uint16_t Thread = 0;
+    uint16_t Depth = 0;         // Producer only
+    std::string Name;           // Guarded by m_ThreadsMutex
+};
+
+static thread_local ProfilerThreadBuffer* s_ThreadBuffer = nullptr;
+
+Profiler& Profiler::Get()
+{
+    static Profiler s_Profiler;
+    return s_Profiler;
+}
+
+int64_t Profiler::Now()
+{
+    static const auto s_Epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_Epoch).count();
+}
+
+Profiler::~Profiler() = default;
+
+ProfilerThreadBuffer& Profiler::GetThreadBuffer()
+{
+    if (s_ThreadBuffer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+        m_Threads.push_back(std::make_unique<ProfilerThreadBuffer>());
+        s_ThreadBuffer = m_Threads.back().get();
+        s_ThreadBuffer->Thread = static_cast<uint16_t>(m_Threads.size() - 1);
+        s_ThreadBuffer->Name = "Thread " + std::to_string(m_Threads.size() - 1);
+    }
+    return *s_ThreadBuffer;
+}
+
+void Profiler::SetThreadName(const std::string& name)
+{
+    ProfilerThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+    buffer.Name = name;
+}
+
+std::vector<std::string> Profiler::GetThreadNames() const
+{
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+    std::vector<std::string> names;
+    names.reserve(m_Threads.size());
+    for (const std::unique_ptr<ProfilerThreadBuffer>& buffer : m_Threads)
+    {
+        names.push_back(buffer->Name);
+    }
+    return names;
+}
+
+uint16_t Profiler::PushScope()
+{
+    return GetThreadBuffer().Depth++;
+}
+
+void Profiler::PopScope(const char* name, int64_t startNs, uint16_t depth)
+{
+    ProfilerThreadBuffer& buffer = *s_ThreadBuffer;
+    buffer.Depth = depth;
+
+    const uint64_t writeIndex = buffer.WriteIndex.load(std::memory_order_relaxed);
+    ProfileEvent& event = buffer.Events[writeIndex % RingCapacity];
+    event.Name = name;
+    event.StartNs = startNs;
+    event.EndNs = Now();
+    event.Depth = depth;
+    event.Thread = buffer.Thread;
+    buffer.WriteIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+void Profiler::CollectThread(ProfilerThreadBuffer& buffer, std::vector<ProfileEvent>& outEvents)
+{
+    const uint64_t writeIndex = buffer.WriteIndex.load(std::memory_order_acquire);
+    if (writeIndex - buffer.ReadIndex > RingCapacity)
+    {
+        m_DroppedEvents += writeIndex - buffer.ReadIndex - RingCapacity;
+        buffer.ReadIndex = writeIndex - RingCapacity;
+    }
+
+    const size_t firstEvent = outEvents.size();
+    for (uint64_t index = buffer.ReadIndex; index < writeIndex; ++index)
+    {
+        outEvents.push_back(buffer.Events[index % RingCapacity]);
+    }
+
+    // The producer kept going while we copied; anything it lapped may be torn, so drop it
+    const uint64_t lappedIndex = buffer.WriteIndex.load(std::memory_order_acquire);
+    if (lappedIndex - buffer.ReadIndex > RingCapacity)
+    {
+        const size_t torn = static_cast<size_t>(std::min<uint64_t>(lappedIndex - buffer.ReadIndex - RingCapacity, writeIndex - buffer.ReadIndex));
+        outEvents.erase(outEvents.begin() + firstEvent, outEvents.begin() + firstEvent + torn);
+        m_DroppedEvents += torn;
+    }
+    buffer.ReadIndex = writeIndex;
+}
+
+void Profiler::BeginFrame()
+{
+    const int64_t nowNs = Now();
+    m_FrameThread = GetThreadBuffer().Thread;
+
+    m_Collected.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+        for (const std::unique_ptr<ProfilerThreadBuffer>& buffer : m_Threads)
+        {
+            CollectThread(*buffer, m_Collected);
+        }
+    }
+    UpdateScopeStats(m_Collected);
+    CaptureFrame(nowNs);
+
+    if (!m_Paused && m_FrameStartNs > 0)
+    {
+        m_LastFrame.StartNs = m_FrameStartNs;
+        m_LastFrame.EndNs = nowNs;
+        m_LastFrame.Events.swap(m_Collected);
+    }
+    m_FrameStartNs = nowNs;
+}
+
+size_t Profiler::GetScopeIndex(const char* name)
+{
+    auto it = m_ScopeIndex.find(name);
+    if (it != m_ScopeIndex.end())
+        return it->second;
+
+    // The same literal can have a different address in another translation unit
+    size_t index = 0;
+    while (index < m_ScopeStats.size() && std::strcmp(m_ScopeStats[index].Name, name) != 0)
+    {
+        ++index;
+    }
+    if (index == m_ScopeStats.size())
+    {
+        m_ScopeStats.push_back(ProfileScopeStats{});
+        m_ScopeStats.back().Name = name;
+        m_ScopeSamples.push_back(ScopeSamples{});
+        m_ScopeSamples.back().DurationsMs.reserve(SampleWindow);
+    }
+    m_ScopeIndex.emplace(name, index);
+    return index;
+}
+
+void Profiler::UpdateScopeStats(const std::vector<ProfileEvent>& events)
+{
+    for (ProfileScopeStats& stats : m_ScopeStats)
+    {
+        stats.CallsLastFrame = 0;
+        stats.TotalMsLastFrame = 0.0;
+    }
+
+    for (const ProfileEvent& event : events)
+    {
+        const size_t index = GetScopeIndex(event.Name);
+        const double durationMs = (event.EndNs - event.StartNs) / 1000000.0;
+
+        ProfileScopeStats& stats = m_ScopeStats[index];
+        stats.CallsLastFrame++;
+        stats.TotalMsLastFrame += durationMs;
+
+        ScopeSamples& samples = m_ScopeSamples[index];
+        if (samples.DurationsMs.size() < SampleWindow)
+            samples.DurationsMs.push_back(durationMs);
+        else
+            samples.DurationsMs[samples.Next] = durationMs;
+        samples.Next = (samples.Next + 1) % SampleWindow;
+        samples.Updated = true;
+    }
+
+    // Nearest-rank percentiles, recomputed only for scopes that ran this frame
+    auto percentile = [this](double fraction)
+    {
+        size_t rank = static_cast<size_t>(fraction * m_SortScratch.size() + 0.999999);
+        return m_SortScratch[std::min(std::max<size_t>(rank, 1), m_SortScratch.size()) - 1];
+    };
+    for (size_t index = 0; index < m_ScopeSamples.size(); ++index)
+    {
+        ScopeSamples& samples = m_ScopeSamples[index];
+        if (!samples.Updated)
+            continue;
+        samples.Updated = false;
+
+        m_SortScratch.assign(samples.DurationsMs.begin(), samples.DurationsMs.end());
+        std::sort(m_SortScratch.begin(), m_SortScratch.end());
+        m_ScopeStats[index].P50Ms = percentile(0.50);
+        m_ScopeStats[index].P95Ms = percentile(0.95);
+        m_ScopeStats[index].P99Ms = percentile(0.99);
+    }
+}
+
+bool Profiler::StartCapture(size_t frameCount, const std::string& path)
+{
+    if (IsCapturing() || frameCount == 0)
+        return false;
+
+    m_Capture.clear();
+    m_Capture.reserve(MaxCaptureEvents);
+    m_CapturePath = path;
+    m_CaptureFramesLeft = frameCount;
+    m_CaptureDropped = 0;
+    m_CaptureStarted = false;
+    m_CaptureWritten = false;
+    return true;
+}
+
+void Profiler::CaptureFrame(int64_t frameEndNs)
+{
+    if (m_CaptureFramesLeft == 0)
+        return;
+
+    // The frame that just ended was already running when the capture was requested
+    if (!m_CaptureStarted)
+    {
+        m_CaptureStarted = true;
+        return;
+    }
+
+    // One span per frame on the main thread, so frame boundaries show up in the viewer
+    ProfileEvent frame;
+    frame.Name = "Frame";
+    frame.StartNs = m_FrameStartNs;
+    frame.EndNs = frameEndNs;
+    frame.Thread = m_FrameThread;
+    const size_t room = m_Capture.capacity() - m_Capture.size();
+    if (room > 0)
+        m_Capture.push_back(frame);
+    else
+        m_CaptureDropped++;
+
+    const size_t copied = std::min(m_Collected.size(), room > 0 ? room - 1 : 0);
+    m_Capture.insert(m_Capture.end(), m_Collected.begin(), m_Collected.begin() + copied);
+    m_CaptureDropped += m_Collected.size() - copied;
+
+    if (--m_CaptureFramesLeft == 0)
+        m_CaptureWritten = WriteCapture();
+}
+
+static void WriteJsonString(FILE* file, const char* text)
+{
+    std::fputc('"', file);
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            std::fputc('\\', file);
+        if (static_cast<unsigned char>(*c) >= 0x20)
+            std::fputc(*c, file);
+    }
+    std::fputc('"', file);
+}
+
+bool Profiler::WriteCapture() const
+{
+    FILE* file = std::fopen(m_CapturePath.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    // Complete ("X") events with microsecond timestamps; one process, one tid per profiled thread
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":%zu},\"traceEvents\":[\n", m_CaptureDropped);
+    const std::vector<std::string> threadNames = GetThreadNames();
+    for (size_t thread = 0; thread < threadNames.size(); ++thread)
+    {
+        std::fprintf(file, "{\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"name\":\"thread_name\",\"args\":{\"name\":", thread);
+        WriteJsonString(file, threadNames[thread].c_str());
+        std::fprintf(file, "}},\n{\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%zu}},\n", thread, thread);
+    }
+    for (size_t index = 0; index < m_Capture.size(); ++index)
+    {
+        const ProfileEvent& event = m_Capture[index];
+        std::fputs("{\"ph\":\"X\",\"pid\":1,\"name\":", file);
+        WriteJsonString(file, event.Name);
+        std::fprintf(file, ",\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n", static_cast<unsigned>(event.Thread), event.StartNs / 1000.0,
+                     (event.EndNs - event.StartNs) / 1000.0, index + 1 < m_Capture.size() ? "," : "");
+    }
+    std::fputs("]}\n", file);
+
+    const bool succeeded = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && succeeded;
+}
+
+#endif
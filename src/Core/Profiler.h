@@ -0,0 +1,164 @@
+#pragma once
+
+// Frame-phase CPU profiler. PROFILE_SCOPE times the enclosing scope into a ring buffer owned by
+// the calling thread; once per frame the main thread collects every thread's buffer into a
+// timeline of the last frame and rolling per-scope percentiles, and can capture a run of frames
+// to a Chrome Trace Event JSON file for chrome://tracing or Perfetto.
+// Without FORGED_FLIGHT_PROFILER (Release builds) the macros expand to nothing and the profiler
+// itself is not compiled.
+
+#ifdef FORGED_FLIGHT_PROFILER
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ProfileEvent
+{
+    const char* Name = nullptr;
+    int64_t StartNs = 0;        // Since the profiler epoch
+    int64_t EndNs = 0;
+    uint16_t Depth = 0;         // Nesting level on its thread
+    uint16_t Thread = 0;        // Index into Profiler::GetThreadNames
+};
+
+// Events that completed between two BeginFrame calls; worker scopes may have started earlier
+struct ProfileFrame
+{
+    int64_t StartNs = 0;
+    int64_t EndNs = 0;
+    std::vector<ProfileEvent> Events;
+};
+
+struct ProfileScopeStats
+{
+    const char* Name = nullptr;
+    size_t CallsLastFrame = 0;
+    double TotalMsLastFrame = 0.0;
+    double P50Ms = 0.0;         // Over the last SampleWindow calls
+    double P95Ms = 0.0;
+    double P99Ms = 0.0;
+};
+
+struct ProfilerThreadBuffer;
+
+class Profiler
+{
+public:
+    static constexpr size_t RingCapacity = 8192;    // Events buffered per thread between collections
+    static constexpr size_t SampleWindow = 512;     // Durations kept per scope for the percentiles
+    static constexpr size_t MaxCaptureEvents = 1 << 18;
+
+    static Profiler& Get();
+    static int64_t Now();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Closes the current frame and starts the next; main thread, once per frame
+    void BeginFrame();
+
+    // Labels the calling thread's timeline row
+    void SetThreadName(const std::string& name);
+
+    // Used by ScopedProfileTimer
+    uint16_t PushScope();
+    void PopScope(const char* name, int64_t startNs, uint16_t depth);
+
+    // A paused profiler keeps showing the same frame but still updates the statistics
+    void SetPaused(bool paused) { m_Paused = paused; }
+    bool IsPaused() const { return m_Paused; }
+
+    // Records every scope of the next frameCount frames and writes them to path as Chrome Trace
+    // Event JSON after the last one. The capture buffer is allocated here, up front, so recording
+    // adds nothing to the captured frames; events past MaxCaptureEvents are counted and dropped.
+    bool StartCapture(size_t frameCount, const std::string& path);
+    bool IsCapturing() const { return m_CaptureFramesLeft > 0; }
+    size_t GetCaptureFramesLeft() const { return m_CaptureFramesLeft; }
+    size_t GetCapturedEventCount() const { return m_Capture.size(); }
+    const std::string& GetCapturePath() const { return m_CapturePath; }
+    bool WasCaptureWritten() const { return m_CaptureWritten; }
+
+    const ProfileFrame& GetLastFrame() const { return m_LastFrame; }
+    const std::vector<ProfileScopeStats>& GetScopeStats() const { return m_ScopeStats; }
+    std::vector<std::string> GetThreadNames() const;
+    size_t GetDroppedEvents() const { return m_DroppedEvents; }
+
+private:
+    struct ScopeSamples
+    {
+        std::vector<double> DurationsMs;    // Ring of the last SampleWindow calls
+        size_t Next = 0;
+        bool Updated = false;
+    };
+
+    Profiler() = default;
+    ~Profiler();
+
+    ProfilerThreadBuffer& GetThreadBuffer();
+    void CollectThread(ProfilerThreadBuffer& buffer, std::vector<ProfileEvent>& outEvents);
+    size_t GetScopeIndex(const char* name);
+    void UpdateScopeStats(const std::vector<ProfileEvent>& events);
+    void CaptureFrame(int64_t frameEndNs);
+    bool WriteCapture() const;
+
+    mutable std::mutex m_ThreadsMutex;
+    std::vector<std::unique_ptr<ProfilerThreadBuffer>> m_Threads;   // Never freed: threads may exit mid-frame
+
+    // Main thread only
+    int64_t m_FrameStartNs = 0;
+    ProfileFrame m_LastFrame;
+    std::vector<ProfileEvent> m_Collected;
+    std::unordered_map<const char*, size_t> m_ScopeIndex;
+    std::vector<ScopeSamples> m_ScopeSamples;
+    std::vector<ProfileScopeStats> m_ScopeStats;
+    std::vector<double> m_SortScratch;
+    size_t m_DroppedEvents = 0;
+    bool m_Paused = false;
+    uint16_t m_FrameThread = 0;
+
+    // Trace capture; recording starts with the first frame that begins after StartCapture
+    std::vector<ProfileEvent> m_Capture;
+    std::string m_CapturePath;
+    size_t m_CaptureFramesLeft = 0;
+    size_t m_CaptureDropped = 0;
+    bool m_CaptureStarted = false;
+    bool m_CaptureWritten = false;
+};
+
+class ScopedProfileTimer
+{
+public:
+    explicit ScopedProfileTimer(const char* name)
+        : m_Name(name), m_Depth(Profiler::Get().PushScope()), m_StartNs(Profiler::Now())
+    {
+    }
+
+    ~ScopedProfileTimer() { Profiler::Get().PopScope(m_Name, m_StartNs, m_Depth); }
+
+    ScopedProfileTimer(const ScopedProfileTimer&) = delete;
+    ScopedProfileTimer& operator=(const ScopedProfileTimer&) = delete;
+
+private:
+    const char* m_Name;
+    uint16_t m_Depth;
+    int64_t m_StartNs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ScopedProfileTimer PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::Get().BeginFrame()
+#define PROFILE_THREAD(name) Profiler::Get().SetThreadName(name)
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+
+#endif
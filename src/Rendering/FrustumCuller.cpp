@@ -0,0 +1,147 @@
+#include "FrustumCuller.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define FRUSTUM_CULLER_SSE 1
+#endif
+
+Frustum Frustum::FromViewProjection(const float4x4& viewProj)
+{
+    // clip = v * M, so each clip component is the dot product with a column of M
+    auto column = [&viewProj](int c) {
+        return FrustumPlane{viewProj.m[0][c], viewProj.m[1][c], viewProj.m[2][c], viewProj.m[3][c]};
+    };
+    auto add = [](const FrustumPlane& p, const FrustumPlane& q) { return FrustumPlane{p.a + q.a, p.b + q.b, p.c + q.c, p.d + q.d}; };
+    auto sub = [](const FrustumPlane& p, const FrustumPlane& q) { return FrustumPlane{p.a - q.a, p.b - q.b, p.c - q.c, p.d - q.d}; };
+
+    const FrustumPlane x = column(0);
+    const FrustumPlane y = column(1);
+    const FrustumPlane z = column(2);
+    const FrustumPlane w = column(3);
+
+    Frustum frustum;
+    frustum.Planes[0] = add(w, x); // -w <= x
+    frustum.Planes[1] = sub(w, x); //  x <= w
+    frustum.Planes[2] = add(w, y); // -w <= y
+    frustum.Planes[3] = sub(w, y); //  y <= w
+    frustum.Planes[4] = z;         //  0 <= z
+    frustum.Planes[5] = sub(w, z); //  z <= w
+
+    for (FrustumPlane& plane : frustum.Planes)
+    {
+        float length = std::sqrt(plane.a * plane.a + plane.b * plane.b + plane.c * plane.c);
+        if (length > 0.0f)
+        {
+            plane.a /= length;
+            plane.b /= length;
+            plane.c /= length;
+            plane.d /= length;
+        }
+    }
+    return frustum;
+}
+
+size_t AABBArray::Add(const float3& min, const float3& max)
+{
+    size_t index = m_Count++;
+    size_t paddedSize = (m_Count + 3) & ~size_t(3);
+    if (m_MinX.size() < paddedSize)
+    {
+        for (std::vector<float>* component : {&m_MinX, &m_MinY, &m_MinZ, &m_MaxX, &m_MaxY, &m_MaxZ})
+            component->resize(paddedSize, 0.0f);
+    }
+    Set(index, min, max);
+    return index;
+}
+
+void AABBArray::Set(size_t index, const float3& min, const float3& max)
+{
+    m_MinX[index] = min.x;
+    m_MinY[index] = min.y;
+    m_MinZ[index] = min.z;
+    m_MaxX[index] = max.x;
+    m_MaxY[index] = max.y;
+    m_MaxZ[index] = max.z;
+}
+
+void AABBArray::RemoveSwap(size_t index)
+{
+    size_t last = --m_Count;
+    if (index != last)
+    {
+        m_MinX[index] = m_MinX[last];
+        m_MinY[index] = m_MinY[last];
+        m_MinZ[index] = m_MinZ[last];
+        m_MaxX[index] = m_MaxX[last];
+        m_MaxY[index] = m_MaxY[last];
+        m_MaxZ[index] = m_MaxZ[last];
+    }
+}
+
+void AABBArray::Clear()
+{
+    m_Count = 0;
+    for (std::vector<float>* component : {&m_MinX, &m_MinY, &m_MinZ, &m_MaxX, &m_MaxY, &m_MaxZ})
+        component->clear();
+}
+
+size_t AABBArray::Cull(const Frustum& frustum, std::vector<uint32_t>& outVisible) const
+{
+    // A box is outside if its corner furthest along a plane normal (the "positive vertex")
+    // is behind that plane. The corner is picked per plane from the sign of the normal.
+    const float* cornerX[6];
+    const float* cornerY[6];
+    const float* cornerZ[6];
+    for (int p = 0; p < 6; ++p)
+    {
+        const FrustumPlane& plane = frustum.Planes[p];
+        cornerX[p] = plane.a >= 0.0f ? m_MaxX.data() : m_MinX.data();
+        cornerY[p] = plane.b >= 0.0f ? m_MaxY.data() : m_MinY.data();
+        cornerZ[p] = plane.c >= 0.0f ? m_MaxZ.data() : m_MinZ.data();
+    }
+
+    size_t visibleCount = 0;
+    for (size_t base = 0; base < m_Count; base += 4)
+    {
+#ifdef FRUSTUM_CULLER_SSE
+        __m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps()); // All lanes set
+        for (int p = 0; p < 6; ++p)
+        {
+            const FrustumPlane& plane = frustum.Planes[p];
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.a), _mm_loadu_ps(cornerX[p] + base)),
+                                         _mm_mul_ps(_mm_set1_ps(plane.b), _mm_loadu_ps(cornerY[p] + base)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.c), _mm_loadu_ps(cornerZ[p] + base)));
+            distance = _mm_add_ps(distance, _mm_set1_ps(plane.d));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(inside);
+#else
+        int mask = 0;
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            bool laneInside = true;
+            for (int p = 0; p < 6 && laneInside; ++p)
+            {
+                const FrustumPlane& plane = frustum.Planes[p];
+                size_t i = base + lane;
+                laneInside = plane.a * cornerX[p][i] + plane.b * cornerY[p][i] + plane.c * cornerZ[p][i] + plane.d >= 0.0f;
+            }
+            mask |= laneInside ? (1 << lane) : 0;
+        }
+#endif
+        // Ignore the padding lanes of the last group
+        if (m_Count - base < 4)
+            mask &= (1 << (m_Count - base)) - 1;
+
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            if (mask & (1 << lane))
+            {
+                outVisible.push_back(static_cast<uint32_t>(base + lane));
+                visibleCount++;
+            }
+        }
+    }
+    return visibleCount;
+}
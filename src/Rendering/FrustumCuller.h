@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Common/interface/BasicMath.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace Diligent;
+
+// Plane a*x + b*y + c*z + d = 0 with the normal pointing into the frustum
+struct FrustumPlane
+{
+    float a, b, c, d;
+};
+
+struct Frustum
+{
+    FrustumPlane Planes[6]; // Left, Right, Bottom, Top, Near, Far
+
+    // Extracts world-space planes from a row-vector view-projection matrix (D3D clip depth 0..1)
+    static Frustum FromViewProjection(const float4x4& viewProj);
+};
+
+// Axis-aligned boxes stored as structure-of-arrays, so the culler tests four boxes per SSE step.
+// Boxes are addressed by index; removal swaps the last box into the freed slot.
+class AABBArray
+{
+public:
+    size_t Add(const float3& min, const float3& max);
+    void Set(size_t index, const float3& min, const float3& max);
+    void RemoveSwap(size_t index);
+    void Clear();
+    size_t Size() const { return m_Count; }
+
+    // Appends the indices of all boxes that intersect the frustum; returns how many were visible
+    size_t Cull(const Frustum& frustum, std::vector<uint32_t>& outVisible) const;
+
+private:
+    // Arrays are kept padded to a multiple of four so SIMD loads never run past the end
+    std::vector<float> m_MinX, m_MinY, m_MinZ;
+    std::vector<float> m_MaxX, m_MaxY, m_MaxZ;
+    size_t m_Count = 0;
+};
@@ -0,0 +1,89 @@
+#include "BlockSlab.h"
+#include "BlockStorage.h"
+#include <cstring>
+
+BlockSlab& BlockSlab::Get()
+{
+    static BlockSlab s_Slab;
+    return s_Slab;
+}
+
+BlockSlab::BlockSlab()
+{
+    for (int i = 0; i < SizeClassCount; ++i)
+    {
+        m_Classes[i].WordCount = static_cast<size_t>(CHUNK_VOLUME) * (1 << i) / 64;
+    }
+}
+
+uint64_t* BlockSlab::Allocate(int bitsPerBlock)
+{
+    SizeClass& sizeClass = m_Classes[GetSizeClass(bitsPerBlock)];
+    uint64_t* block;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (sizeClass.FreeList == nullptr)
+            AddPage(sizeClass);
+
+        // The first word of a free block links to the next one
+        block = sizeClass.FreeList;
+        std::memcpy(&sizeClass.FreeList, block, sizeof(uint64_t*));
+        sizeClass.BlocksInUse++;
+        m_BlocksServed++;
+    }
+
+    std::memset(block, 0, sizeClass.WordCount * sizeof(uint64_t));
+    return block;
+}
+
+void BlockSlab::Free(uint64_t* block, int bitsPerBlock)
+{
+    if (block == nullptr)
+        return;
+
+    SizeClass& sizeClass = m_Classes[GetSizeClass(bitsPerBlock)];
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::memcpy(block, &sizeClass.FreeList, sizeof(uint64_t*));
+    sizeClass.FreeList = block;
+    sizeClass.BlocksInUse--;
+}
+
+BlockSlabStats BlockSlab::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    BlockSlabStats stats;
+    stats.PageAllocations = m_PageAllocations;
+    stats.BytesReserved = m_BytesReserved;
+    stats.BlocksServed = m_BlocksServed;
+    for (const SizeClass& sizeClass : m_Classes)
+    {
+        stats.BlocksInUse += sizeClass.BlocksInUse;
+    }
+    return stats;
+}
+
+int BlockSlab::GetSizeClass(int bitsPerBlock)
+{
+    switch (bitsPerBlock)
+    {
+    case 1: return 0;
+    case 2: return 1;
+    case 4: return 2;
+    default: return 3;
+    }
+}
+
+void BlockSlab::AddPage(SizeClass& sizeClass)
+{
+    // Thread the new page's blocks onto the free list, first block on top
+    std::unique_ptr<uint64_t[]> page(new uint64_t[sizeClass.WordCount * BlocksPerPage]);
+    for (size_t i = BlocksPerPage; i-- > 0;)
+    {
+        uint64_t* block = page.get() + i * sizeClass.WordCount;
+        std::memcpy(block, &sizeClass.FreeList, sizeof(uint64_t*));
+        sizeClass.FreeList = block;
+    }
+    sizeClass.Pages.push_back(std::move(page));
+    m_PageAllocations++;
+    m_BytesReserved += sizeClass.WordCount * BlocksPerPage * sizeof(uint64_t);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct BlockSlabStats
+{
+    size_t PageAllocations = 0;     // Heap allocations made by the slab
+    size_t BytesReserved = 0;
+    size_t BlocksInUse = 0;
+    size_t BlocksServed = 0;        // Allocate calls answered, almost all from the free lists
+};
+
+// Fixed-block allocator for the packed voxel indices of BlockStorage.
+// A chunk's index array comes in exactly four sizes (1, 2, 4 or 8 bits per voxel), so each width
+// gets its own size class: pages of equal blocks with an intrusive free list. Freed blocks are
+// reused by the next chunk and pages are never returned, so streaming settles into a fixed
+// footprint with no heap traffic. Shared by the generation workers and the main thread.
+class BlockSlab
+{
+public:
+    static BlockSlab& Get();
+
+    BlockSlab(const BlockSlab&) = delete;
+    BlockSlab& operator=(const BlockSlab&) = delete;
+
+    // bitsPerBlock is 1, 2, 4 or 8; the block holds CHUNK_VOLUME indices of that width, zeroed
+    uint64_t* Allocate(int bitsPerBlock);
+    void Free(uint64_t* block, int bitsPerBlock);
+
+    BlockSlabStats GetStats() const;
+
+private:
+    static constexpr int SizeClassCount = 4;
+    static constexpr size_t BlocksPerPage = 64;
+
+    struct SizeClass
+    {
+        size_t WordCount = 0;
+        std::vector<std::unique_ptr<uint64_t[]>> Pages;
+        uint64_t* FreeList = nullptr;
+        size_t BlocksInUse = 0;
+    };
+
+    BlockSlab();
+    static int GetSizeClass(int bitsPerBlock);
+    void AddPage(SizeClass& sizeClass);
+
+    SizeClass m_Classes[SizeClassCount];
+    mutable std::mutex m_Mutex;
+    size_t m_PageAllocations = 0;
+    size_t m_BytesReserved = 0;
+    size_t m_BlocksServed = 0;
+};
@@ -0,0 +1,184 @@
+#include "BlockStorage.h"
+#include "BlockSlab.h"
+#include <algorithm>
+
+BlockStorage::BlockStorage()
+{
+    // Room for every block type, so the palette never regrows as a recycled chunk is re-encoded
+    m_Palette.reserve(static_cast<size_t>(BlockType::Count));
+    Fill(BlockType::Air);
+}
+
+BlockStorage::~BlockStorage()
+{
+    ReleaseData();
+}
+
+BlockType BlockStorage::Get(int index) const
+{
+    if (m_BitsPerBlock == 0)
+        return m_Palette[0];
+    
+    return m_Palette[GetPaletteIndex(index)];
+}
+
+void BlockStorage::Set(int index, BlockType type)
+{
+    int paletteIndex = FindPaletteIndex(type);
+    if (paletteIndex < 0)
+    {
+        // Widen the indices if the new palette entry doesn't fit
+        // (a uniform storage expands to 1 bit per voxel on its first differing write)
+        if (m_Palette.size() >= (size_t(1) << m_BitsPerBlock))
+        {
+            Resize(m_BitsPerBlock == 0 ? 1 : m_BitsPerBlock * 2);
+        }
+        paletteIndex = static_cast<int>(m_Palette.size());
+        m_Palette.push_back(type);
+    }
+
+    if (m_BitsPerBlock > 0)
+    {
+        SetPaletteIndex(index, static_cast<uint32_t>(paletteIndex));
+    }
+}
+
+void BlockStorage::Fill(BlockType type)
+{
+    m_Palette.assign(1, type);
+    ReleaseData();
+}
+
+void BlockStorage::DecodeTo(BlockType* outBlocks) const
+{
+    if (m_BitsPerBlock == 0)
+    {
+        std::fill(outBlocks, outBlocks + CHUNK_VOLUME, m_Palette[0]);
+        return;
+    }
+    
+    const int blocksPerWord = 64 / m_BitsPerBlock;
+    const uint64_t mask = (uint64_t(1) << m_BitsPerBlock) - 1;
+
+    int index = 0;
+    const size_t wordCount = GetWordCount(m_BitsPerBlock);
+    for (size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+    {
+        uint64_t word = m_Data[wordIndex];
+        for (int i = 0; i < blocksPerWord; ++i)
+        {
+            outBlocks[index++] = m_Palette[static_cast<size_t>(word & mask)];
+            word >>= m_BitsPerBlock;
+        }
+    }
+}
+
+void BlockStorage::EncodeFrom(const BlockType* blocks)
+{
+    // Build a compact palette of the types actually present
+    int16_t lookup[256];
+    std::fill(std::begin(lookup), std::end(lookup), int16_t(-1));
+
+    m_Palette.clear();
+    for (int i = 0; i < CHUNK_VOLUME; ++i)
+    {
+        uint8_t type = static_cast<uint8_t>(blocks[i]);
+        if (lookup[type] < 0)
+        {
+            lookup[type] = static_cast<int16_t>(m_Palette.size());
+            m_Palette.push_back(blocks[i]);
+        }
+    }
+
+    // Keep the slab block when the width is unchanged; every word is rewritten below
+    int bitsPerBlock = BitsForPaletteSize(m_Palette.size());
+    if (bitsPerBlock != m_BitsPerBlock)
+    {
+        ReleaseData();
+        m_BitsPerBlock = bitsPerBlock;
+        if (m_BitsPerBlock > 0)
+            m_Data = BlockSlab::Get().Allocate(m_BitsPerBlock);
+    }
+    if (m_BitsPerBlock == 0)
+        return;
+    
+    const int blocksPerWord = 64 / m_BitsPerBlock;
+    const size_t wordCount = GetWordCount(m_BitsPerBlock);
+
+    int index = 0;
+    for (size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+    {
+        uint64_t& word = m_Data[wordIndex];
+        uint64_t packed = 0;
+        for (int i = 0; i < blocksPerWord; ++i)
+        {
+            packed |= static_cast<uint64_t>(lookup[static_cast<uint8_t>(blocks[index++])]) << (i * m_BitsPerBlock);
+        }
+        word = packed;
+    }
+}
+
+size_t BlockStorage::GetMemoryUsage() const
+{
+    return sizeof(BlockStorage) + m_Palette.capacity() * sizeof(BlockType) + GetWordCount(m_BitsPerBlock) * sizeof(uint64_t);
+}
+
+int BlockStorage::FindPaletteIndex(BlockType type) const
+{
+    for (size_t i = 0; i < m_Palette.size(); ++i)
+    {
+        if (m_Palette[i] == type)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+uint32_t BlockStorage::GetPaletteIndex(int index) const
+{
+    if (m_BitsPerBlock == 0)
+        return 0;
+    
+    const size_t bitOffset = static_cast<size_t>(index) * m_BitsPerBlock;
+    const uint64_t mask = (uint64_t(1) << m_BitsPerBlock) - 1;
+    return static_cast<uint32_t>((m_Data[bitOffset >> 6] >> (bitOffset & 63)) & mask);
+}
+
+void BlockStorage::SetPaletteIndex(int index, uint32_t paletteIndex)
+{
+    const size_t bitOffset = static_cast<size_t>(index) * m_BitsPerBlock;
+    const uint64_t mask = (uint64_t(1) << m_BitsPerBlock) - 1;
+    uint64_t& word = m_Data[bitOffset >> 6];
+    word = (word & ~(mask << (bitOffset & 63))) | (static_cast<uint64_t>(paletteIndex) << (bitOffset & 63));
+}
+
+void BlockStorage::Resize(int bitsPerBlock)
+{
+    // Repack every index at the new width (bit widths always divide 64, so no index straddles a word)
+    uint64_t* newData = BlockSlab::Get().Allocate(bitsPerBlock);
+    for (int i = 0; i < CHUNK_VOLUME; ++i)
+    {
+        const size_t bitOffset = static_cast<size_t>(i) * bitsPerBlock;
+        newData[bitOffset >> 6] |= static_cast<uint64_t>(GetPaletteIndex(i)) << (bitOffset & 63);
+    }
+
+    ReleaseData();
+    m_Data = newData;
+    m_BitsPerBlock = bitsPerBlock;
+}
+
+void BlockStorage::ReleaseData()
+{
+    if (m_Data != nullptr)
+        BlockSlab::Get().Free(m_Data, m_BitsPerBlock);
+    m_Data = nullptr;
+    m_BitsPerBlock = 0;
+}
+
+int BlockStorage::BitsForPaletteSize(size_t paletteSize)
+{
+    if (paletteSize <= 1) return 0;
+    if (paletteSize <= 2) return 1;
+    if (paletteSize <= 4) return 2;
+    if (paletteSize <= 16) return 4;
+    return 8;
+}
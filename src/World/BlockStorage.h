@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Block.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr int CHUNK_X_SIZE = 16;
+constexpr int CHUNK_Y_SIZE = 16;
+constexpr int CHUNK_Z_SIZE = 16;
+constexpr int CHUNK_VOLUME = CHUNK_X_SIZE * CHUNK_Y_SIZE * CHUNK_Z_SIZE;
+
+// Linear voxel index inside a chunk (X fastest, then Z, then Y)
+inline int ChunkBlockIndex(int x, int y, int z)
+{
+    return x + CHUNK_X_SIZE * (z + CHUNK_Z_SIZE * y);
+}
+
+// Palette-compressed block storage for a single chunk.
+// Each voxel stores an index into a per-chunk palette, bit-packed at 1/2/4/8 bits
+// per voxel. The index width is widened automatically when the palette outgrows it.
+// A chunk made of a single block type uses 0 bits: just the palette entry, no index data.
+// Index arrays come from the shared BlockSlab rather than the heap.
+class BlockStorage
+{
+public:
+    BlockStorage();
+    ~BlockStorage();
+
+    BlockStorage(const BlockStorage&) = delete;
+    BlockStorage& operator=(const BlockStorage&) = delete;
+
+    BlockType Get(int index) const;
+    void Set(int index, BlockType type);
+
+    // Reset every voxel to a single block type
+    void Fill(BlockType type);
+
+    // Bulk conversion to/from a dense array of CHUNK_VOLUME block types
+    void DecodeTo(BlockType* outBlocks) const;
+    void EncodeFrom(const BlockType* blocks);
+
+    bool IsUniform() const { return m_BitsPerBlock == 0; }
+    BlockType GetUniformType() const { return m_Palette[0]; }
+    int GetBitsPerBlock() const { return m_BitsPerBlock; }
+    size_t GetPaletteSize() const { return m_Palette.size(); }
+    size_t GetMemoryUsage() const;
+
+private:
+    std::vector<BlockType> m_Palette;
+    uint64_t* m_Data = nullptr;     // Slab block of GetWordCount(m_BitsPerBlock) words, null when uniform
+    int m_BitsPerBlock = 0;
+
+    static size_t GetWordCount(int bitsPerBlock) { return static_cast<size_t>(CHUNK_VOLUME) * bitsPerBlock / 64; }
+    void ReleaseData();
+
+    int FindPaletteIndex(BlockType type) const;
+    uint32_t GetPaletteIndex(int index) const;
+    void SetPaletteIndex(int index, uint32_t paletteIndex);
+    void Resize(int bitsPerBlock);
+    static int BitsForPaletteSize(size_t paletteSize);
+};
@@ -1,22 +1,16 @@
 #include "Chunk.h"
-#include "VoxelWorld.h"
+#include "ChunkMesher.h"
+#include "MeshBufferPool.h"
+#include "WorldGenerator.h"
+#include "../Core/Profiler.h"
+#include <algorithm>
 #include <random>
 #include <cmath>
 
 Chunk::Chunk(int x, int y, int z)
     : m_ChunkX(x), m_ChunkY(y), m_ChunkZ(z)
 {
-    // Initialize all blocks to air
-    for (int x = 0; x < CHUNK_X_SIZE; ++x)
-    {
-        for (int y = 0; y < CHUNK_Y_SIZE; ++y)
-        {
-            for (int z = 0; z < CHUNK_Z_SIZE; ++z)
-            {
-                m_Blocks[x][y][z].type = BlockType::Air;
-            }
-        }
-    }
+    // Block storage starts out as all air
 }
 
 Block Chunk::GetBlock(int x, int y, int z) const
@@ -24,7 +18,7 @@ Block Chunk::GetBlock(int x, int y, int z) const
     if (x < 0 || x >= CHUNK_X_SIZE || y < 0 || y >= CHUNK_Y_SIZE || z < 0 || z >= CHUNK_Z_SIZE)
         return Block{}; // Return air for out-of-bounds
     
-    return m_Blocks[x][y][z];
+    return Block{ m_Blocks.Get(ChunkBlockIndex(x, y, z)) };
 }
 
 void Chunk::SetBlock(int x, int y, int z, BlockType type)
@@ -32,221 +26,107 @@ void Chunk::SetBlock(int x, int y, int z, BlockType type)
     if (x < 0 || x >= CHUNK_X_SIZE || y < 0 || y >= CHUNK_Y_SIZE || z < 0 || z >= CHUNK_Z_SIZE)
         return;
     
-    m_Blocks[x][y][z].type = type;
-    m_Dirty = true;
+    m_Blocks.Set(ChunkBlockIndex(x, y, z), type);
+    UpdateContents();
+    MarkDirty();
 }
 
-void Chunk::Generate()
+void Chunk::Generate(const TerrainColumn& column)
 {
-    // Clear all blocks to air first
-    for (int x = 0; x < CHUNK_X_SIZE; ++x)
+    PROFILE_SCOPE("Chunk::Generate");
+    // Chunks entirely above the surface or inside the stone are classified without touching voxels
+    std::array<BlockType, CHUNK_VOLUME> blocks;
+    ChunkContents contents = WorldGenerator::GenerateBlocks(m_ChunkY, column, blocks.data());
+    if (contents == ChunkContents::UniformAir)
     {
-        for (int y = 0; y < CHUNK_Y_SIZE; ++y)
-        {
-            if (y == 0) // Bedrock layer
-            {
-                for (int z = 0; z < CHUNK_Z_SIZE; ++z)
-                {
-                    m_Blocks[x][y][z].type = BlockType::Stone;
-                }
-                continue;
-            }
-            for (int z = 0; z < CHUNK_Z_SIZE; ++z)
-            {
-                m_Blocks[x][y][z].type = BlockType::Air;
-            }
-        }
+        m_Blocks.Fill(BlockType::Air);
+        m_Contents = ChunkContents::UniformAir;
     }
-    
-    // For debugging: place blocks to see chunk positioning
-    if (m_ChunkY == 0 && m_ChunkX == 0 && m_ChunkZ == 0)
+    else if (contents == ChunkContents::UniformSolid)
+    {
+        m_Blocks.Fill(BlockType::Stone);
+        m_Contents = ChunkContents::UniformSolid;
+    }
+    else
     {
-        // Origin chunk - place a stone block at (0,0,0)
-        m_Blocks[0][0][0].type = BlockType::Stone;
+        // Pack the dense blocks into the palette storage in one pass; a layer of pure water
+        // or soil still comes out uniform
+        m_Blocks.EncodeFrom(blocks.data());
+        UpdateContents();
     }
     m_Dirty = true;
 }
 
-void Chunk::BuildMesh(VoxelWorld* world)
+void Chunk::FillSnapshot(ChunkSnapshot& snapshot) const
 {
-    if (!m_Dirty)
-        return;
-    
-    m_Vertices.clear();
-    m_Indices.clear();
-    
-    uint32_t indexOffset = 0;
+    // Decode once, then copy rows into the padded layout
+    std::array<BlockType, CHUNK_VOLUME> blocks;
+    m_Blocks.DecodeTo(blocks.data());
     
-    for (int x = 0; x < CHUNK_X_SIZE; ++x)
+    for (int y = 0; y < CHUNK_Y_SIZE; ++y)
     {
-        for (int y = 0; y < CHUNK_Y_SIZE; ++y)
+        for (int z = 0; z < CHUNK_Z_SIZE; ++z)
         {
-            for (int z = 0; z < CHUNK_Z_SIZE; ++z)
-            {
-                Block block = m_Blocks[x][y][z];
-                if (block.type == BlockType::Air)
-                    continue;
-                
-                // Transform local chunk coordinates to world space
-                float3 worldOffset = float3(
-                    static_cast<float>(m_ChunkX * CHUNK_X_SIZE), 
-                    static_cast<float>(m_ChunkY * CHUNK_Y_SIZE), 
-                    static_cast<float>(m_ChunkZ * CHUNK_Z_SIZE)
-                );
-                float3 blockPos = worldOffset + float3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
-                
-                // Check each face of the block - all faces use counter-clockwise winding
-                if (ShouldRenderFace(x, y, z, x, y + 1, z, world)) // Top face
-                {
-                    AddFace(blockPos + float3(0, 1, 0), float3(0, 1, 0), float2(0, 0), float2(1, 1));
-                    m_Indices.insert(m_Indices.end(), {
-                        indexOffset, indexOffset + 1, indexOffset + 2,
-                        indexOffset + 2, indexOffset + 3, indexOffset
-                    });
-                    indexOffset += 4;
-                }
-                
-                if (ShouldRenderFace(x, y, z, x, y - 1, z, world)) // Bottom face
-                {
-                    AddFace(blockPos, float3(0, -1, 0), float2(0, 0), float2(1, 1));
-                    m_Indices.insert(m_Indices.end(), {
-                        indexOffset, indexOffset + 1, indexOffset + 2,
-                        indexOffset + 2, indexOffset + 3, indexOffset
-                    });
-                    indexOffset += 4;
-                }
-                
-                if (ShouldRenderFace(x, y, z, x + 1, y, z, world)) // Right face
-                {
-                    AddFace(blockPos + float3(1, 0, 0), float3(1, 0, 0), float2(0, 0), float2(1, 1));
-                    m_Indices.insert(m_Indices.end(), {
-                        indexOffset, indexOffset + 1, indexOffset + 2,
-                        indexOffset + 2, indexOffset + 3, indexOffset
-                    });
-                    indexOffset += 4;
-                }
-                
-                if (ShouldRenderFace(x, y, z, x - 1, y, z, world)) // Left face
-                {
-                    AddFace(blockPos, float3(-1, 0, 0), float2(0, 0), float2(1, 1));
-                    m_Indices.insert(m_Indices.end(), {
-                        indexOffset, indexOffset + 1, indexOffset + 2,
-                        indexOffset + 2, indexOffset + 3, indexOffset
-                    });
-                    indexOffset += 4;
-                }
-                
-                if (ShouldRenderFace(x, y, z, x, y, z + 1, world)) // Front face
-                {
-                    AddFace(blockPos + float3(0, 0, 1), float3(0, 0, 1), float2(0, 0), float2(1, 1));
-                    m_Indices.insert(m_Indices.end(), {
-                        indexOffset, indexOffset + 1, indexOffset + 2,
-                        indexOffset + 2, indexOffset + 3, indexOffset
-                    });
-                    indexOffset += 4;
-                }
-                
-                if (ShouldRenderFace(x, y, z, x, y, z - 1, world)) // Back face
-                {
-                    AddFace(blockPos, float3(0, 0, -1), float2(0, 0), float2(1, 1));
-                    m_Indices.insert(m_Indices.end(), {
-                        indexOffset, indexOffset + 1, indexOffset + 2,
-                        indexOffset + 2, indexOffset + 3, indexOffset
-                    });
-                    indexOffset += 4;
-                }
-            }
+            std::copy_n(&blocks[ChunkBlockIndex(0, y, z)], CHUNK_X_SIZE, &snapshot.Blocks[ChunkSnapshot::Index(0, y, z)]);
         }
     }
-    
-    m_MeshBuilt = true;
+    snapshot.Contents = m_Contents;
+}
+
+void Chunk::Reset(int x, int y, int z)
+{
+    m_ChunkX = x;
+    m_ChunkY = y;
+    m_ChunkZ = z;
+    m_Blocks.Fill(BlockType::Air);
+    m_Contents = ChunkContents::UniformAir;
+    m_Vertices.clear();
+    m_MeshBuilt = false;
+    m_Dirty = true;
+    // A mesh job still out for the previous occupant can never match a version handed out from here on
+    m_MeshVersion = m_PendingMeshVersion;
+    m_MissingNeighborMask = 0;
+}
+
+uint32_t Chunk::BeginMeshBuild()
+{
     m_Dirty = false;
+    return ++m_PendingMeshVersion;
 }
 
-bool Chunk::ShouldRenderFace(int x, int y, int z, int adjX, int adjY, int adjZ, VoxelWorld* world) const
+bool Chunk::ApplyMesh(const std::vector<ChunkVertex>& vertices, uint8_t missingNeighborMask, uint32_t meshVersion, MeshBufferPool& buffers)
 {
-    // Check if adjacent block is within this chunk
-    if (adjX >= 0 && adjX < CHUNK_X_SIZE && adjY >= 0 && adjY < CHUNK_Y_SIZE && adjZ >= 0 && adjZ < CHUNK_Z_SIZE)
-    {
-        // Adjacent block is in this chunk
-        Block adjacentBlock = m_Blocks[adjX][adjY][adjZ];
-        return adjacentBlock.IsTransparent();
-    }
-    
-    // Adjacent block is outside this chunk - check across chunk boundaries if world is available
-    if (world != nullptr)
-    {
-        // Convert to world coordinates
-        int worldX = m_ChunkX * CHUNK_X_SIZE + adjX;
-        int worldY = m_ChunkY * CHUNK_Y_SIZE + adjY;
-        int worldZ = m_ChunkZ * CHUNK_Z_SIZE + adjZ;
-        
-        Block adjacentBlock = world->GetBlock(worldX, worldY, worldZ);
-        return adjacentBlock.IsTransparent();
-    }
+    // Snapshotted again since: the newer mesh is on its way
+    if (meshVersion != m_PendingMeshVersion)
+        return false;
     
-    // No world context available, assume transparent (render face) for safety
+    // Trade the buffer for one sized for this mesh rather than growing it
+    buffers.Exchange(m_Vertices, vertices.size());
+    m_Vertices.assign(vertices.begin(), vertices.end());
+    m_MissingNeighborMask = missingNeighborMask;
+    m_MeshBuilt = true;
+    m_MeshVersion = meshVersion;
     return true;
 }
 
-void Chunk::AddFace(const float3& pos, const float3& normal, const float2& uvMin, const float2& uvMax)
+void Chunk::ReleaseMeshBuffer(MeshBufferPool& buffers)
 {
-    // Define face vertices based on normal direction with consistent counter-clockwise winding
-    float3 vertices[4];
-    float2 uvs[4] = {
-        {uvMin.x, uvMin.y}, {uvMax.x, uvMin.y}, {uvMax.x, uvMax.y}, {uvMin.x, uvMax.y}
-    };
-    
-    if (normal.y > 0.5f) // Top face (looking down at Y+)
-    {
-        vertices[0] = pos + float3(0, 0, 0);  // Bottom-left
-        vertices[1] = pos + float3(1, 0, 0);  // Bottom-right
-        vertices[2] = pos + float3(1, 0, 1);  // Top-right
-        vertices[3] = pos + float3(0, 0, 1);  // Top-left
-    }
-    else if (normal.y < -0.5f) // Bottom face (looking up at Y-)
-    {
-        vertices[0] = pos + float3(0, 0, 1);  // Top-left
-        vertices[1] = pos + float3(1, 0, 1);  // Top-right
-        vertices[2] = pos + float3(1, 0, 0);  // Bottom-right
-        vertices[3] = pos + float3(0, 0, 0);  // Bottom-left
-    }
-    else if (normal.x > 0.5f) // Right face (looking at X+)
-    {
-        vertices[0] = pos + float3(0, 0, 1);  // Front-bottom
-        vertices[1] = pos + float3(0, 1, 1);  // Front-top
-        vertices[2] = pos + float3(0, 1, 0);  // Back-top
-        vertices[3] = pos + float3(0, 0, 0);  // Back-bottom
-    }
-    else if (normal.x < -0.5f) // Left face (looking at X-)
-    {
-        vertices[0] = pos + float3(0, 0, 0);  // Back-bottom
-        vertices[1] = pos + float3(0, 1, 0);  // Back-top
-        vertices[2] = pos + float3(0, 1, 1);  // Front-top
-        vertices[3] = pos + float3(0, 0, 1);  // Front-bottom
-    }
-    else if (normal.z > 0.5f) // Front face (looking at Z+)
-    {
-        vertices[0] = pos + float3(0, 0, 0);  // Left-bottom
-        vertices[1] = pos + float3(0, 1, 0);  // Left-top
-        vertices[2] = pos + float3(1, 1, 0);  // Right-top
-        vertices[3] = pos + float3(1, 0, 0);  // Right-bottom
-    }
-    else // Back face (looking at Z-)
+    buffers.Exchange(m_Vertices, 0);
+}
+
+void Chunk::UpdateContents()
+{
+    if (!m_Blocks.IsUniform())
     {
-        vertices[0] = pos + float3(1, 0, 0);  // Right-bottom
-        vertices[1] = pos + float3(1, 1, 0);  // Right-top
-        vertices[2] = pos + float3(0, 1, 0);  // Left-top
-        vertices[3] = pos + float3(0, 0, 0);  // Left-bottom
+        m_Contents = ChunkContents::Mixed;
+        return;
     }
     
-    // Add vertices to the mesh (pos + normal + uv = 8 floats per vertex)
-    for (int i = 0; i < 4; ++i)
-    {
-        m_Vertices.insert(m_Vertices.end(), {
-            vertices[i].x, vertices[i].y, vertices[i].z,  // Position
-            normal.x, normal.y, normal.z,                 // Normal
-            uvs[i].x, uvs[i].y                           // UV
-        });
-    }
-}
\ No newline at end of file
+    Block block{ m_Blocks.GetUniformType() };
+    if (block.type == BlockType::Air)
+        m_Contents = ChunkContents::UniformAir;
+    else if (block.IsOpaque())
+        m_Contents = ChunkContents::UniformSolid;
+    else
+        m_Contents = ChunkContents::Mixed; // e.g. all water, which still has visible faces
+}
@@ -1,24 +1,80 @@
 #pragma once
 
 #include "Block.h"
+#include "BlockStorage.h"
 #include "Common/interface/BasicMath.hpp"
 #include <array>
 #include <vector>
 
 using namespace Diligent;
 
-constexpr int CHUNK_X_SIZE = 16;
-constexpr int CHUNK_Y_SIZE = 16;
-constexpr int CHUNK_Z_SIZE = 16;
+// Mesher input, see ChunkMesher.h
+struct ChunkSnapshot;
+struct TerrainColumn;
+class MeshBufferPool;
 
-// Forward declaration for VoxelWorld
-class VoxelWorld;
+// Face directions, in the order the naive mesher emits them
+enum class BlockFace : uint8_t
+{
+    Top = 0,    // +Y
+    Bottom,     // -Y
+    Right,      // +X
+    Left,       // -X
+    Front,      // +Z
+    Back        // -Z
+};
+
+// Packed chunk vertex (8 bytes).
+// Positions are chunk-local (0..16 per axis), the normal is a face index and UVs are
+// derived from the position in the vertex shader; the chunk origin is supplied per draw.
+struct ChunkVertex
+{
+    uint32_t PositionAndFace;   // x:5 | y:5 | z:5 | face:3
+    uint32_t Attributes;        // block type:8 | reserved:24
+    
+    static ChunkVertex Pack(int x, int y, int z, BlockFace face, BlockType type)
+    {
+        ChunkVertex vertex;
+        vertex.PositionAndFace = static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 5) |
+                                 (static_cast<uint32_t>(z) << 10) | (static_cast<uint32_t>(face) << 15);
+        vertex.Attributes = static_cast<uint32_t>(type);
+        return vertex;
+    }
+};
+static_assert(sizeof(ChunkVertex) == 8, "ChunkVertex must stay 8 bytes");
+
+// Chunk meshes are lists of quads (4 vertices each) drawn with a shared index buffer
+// using the pattern (0,1,2, 2,3,0) + 4 * quad. Upper bound: every face of every voxel.
+constexpr int MAX_QUADS_PER_CHUNK = CHUNK_VOLUME * 6;
+constexpr int INDICES_PER_QUAD = 6;
+
+// Mesh generation algorithm
+enum class MeshingMode : uint8_t
+{
+    Naive = 0,  // One quad per visible block face
+    Greedy,     // Coplanar faces of the same block type merged into maximal rectangles
+    Binary,     // Same output as Greedy, with faces culled a whole row of bitmasks at a time
+    Count
+};
+
+// Coarse chunk contents, known straight out of generation.
+// Uniform chunks are stored as a single value and never meshed on their own.
+enum class ChunkContents : uint8_t
+{
+    UniformAir = 0,
+    UniformSolid,
+    Mixed
+};
 
 class Chunk
 {
 public:
     Chunk(int x, int y, int z);
     ~Chunk() = default;
+    
+    // Turns a recycled chunk back into a fresh all-air chunk at a new position; the mesh
+    // buffer keeps its capacity for the next build
+    void Reset(int x, int y, int z);
 
     // Block access
     Block GetBlock(int x, int y, int z) const;
@@ -30,22 +86,45 @@ public:
     int GetChunkY() const { return m_ChunkY; }
     int GetChunkZ() const { return m_ChunkZ; }
     
-    // Generation and mesh building
-    void Generate();
-    void BuildMesh(VoxelWorld* world = nullptr);
+    // Generation and mesh building. Meshing reads a snapshot of the chunk plus its neighbors'
+    // border voxels, gathered by the world, so the mesher never looks anything up and can run
+    // on a worker. Taking the snapshot hands out the version the mesh built from it will have;
+    // only the mesh of the latest snapshot is applied, older ones arrive stale and are refused.
+    void Generate(const TerrainColumn& column);    // From the column's cached 2D terrain data
+    void FillSnapshot(ChunkSnapshot& snapshot) const;   // Interior blocks and contents only
+    uint32_t BeginMeshBuild();                      // Clears the dirty flag; the snapshot is current
+    bool ApplyMesh(const std::vector<ChunkVertex>& vertices, uint8_t missingNeighborMask, uint32_t meshVersion, MeshBufferPool& buffers);
     bool IsMeshBuilt() const { return m_MeshBuilt; }
+    bool IsMeshPending() const { return m_PendingMeshVersion != m_MeshVersion; }
     bool IsDirty() const { return m_Dirty; }
     void MarkDirty() { m_Dirty = true; }
+    uint32_t GetMeshVersion() const { return m_MeshVersion; }   // Version of the mesh in GetVertices
+    
+    // Sides (bit per BlockFace) whose neighbor chunk was not loaded when the mesh was built
+    uint8_t GetMissingNeighborMask() const { return m_MissingNeighborMask; }
+    
+    // Contents classification
+    ChunkContents GetContents() const { return m_Contents; }
+    bool IsUniform() const { return m_Contents != ChunkContents::Mixed; }
+    
+    // Block storage access
+    BlockType GetBlockType(int x, int y, int z) const { return m_Blocks.Get(ChunkBlockIndex(x, y, z)); } // No bounds check
+    void DecodeBlocks(BlockType* outBlocks) const { m_Blocks.DecodeTo(outBlocks); }
+    size_t GetBlockMemoryUsage() const { return m_Blocks.GetMemoryUsage(); }
+    size_t GetMemoryUsage() const { return sizeof(Chunk) - sizeof(BlockStorage) + m_Blocks.GetMemoryUsage() + m_Vertices.capacity() * sizeof(ChunkVertex); }
     
     // Mesh data access
-    const std::vector<float>& GetVertices() const { return m_Vertices; }
-    const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
-    size_t GetVertexCount() const { return m_Vertices.size() / 8; } // 8 floats per vertex (pos + normal + uv)
-    size_t GetIndexCount() const { return m_Indices.size(); }
+    const std::vector<ChunkVertex>& GetVertices() const { return m_Vertices; }
+    size_t GetVertexCount() const { return m_Vertices.size(); }
+    size_t GetQuadCount() const { return m_Vertices.size() / 4; }
+    size_t GetIndexCount() const { return GetQuadCount() * INDICES_PER_QUAD; } // Indices come from the shared quad index buffer
+    void ReleaseMeshBuffer() { std::vector<ChunkVertex>().swap(m_Vertices); }
+    void ReleaseMeshBuffer(MeshBufferPool& buffers);    // Into the pool, for other chunks to mesh into
 
 private:
-    // Block storage
-    std::array<std::array<std::array<Block, CHUNK_Y_SIZE>, CHUNK_X_SIZE>, CHUNK_Z_SIZE> m_Blocks;
+    // Block storage (palette-compressed)
+    BlockStorage m_Blocks;
+    ChunkContents m_Contents = ChunkContents::UniformAir;
     
     // Chunk position
     int m_ChunkX;
@@ -53,13 +132,14 @@ private:
     int m_ChunkZ;
     
     // Mesh data
-    std::vector<float> m_Vertices;
-    std::vector<uint32_t> m_Indices;
+    std::vector<ChunkVertex> m_Vertices;
     bool m_MeshBuilt = false;
     bool m_Dirty = true;
+    uint32_t m_MeshVersion = 0;
+    uint32_t m_PendingMeshVersion = 0;  // Of the latest snapshot; keeps counting across recycling
+    uint8_t m_MissingNeighborMask = 0;
     
     // Helper methods
     bool IsBlockVisible(int x, int y, int z) const;
-    void AddFace(const float3& pos, const float3& normal, const float2& uvMin, const float2& uvMax);
-    bool ShouldRenderFace(int x, int y, int z, int adjX, int adjY, int adjZ, VoxelWorld* world = nullptr) const;
+    void UpdateContents();
 };
\ No newline at end of file
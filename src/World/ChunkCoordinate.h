@@ -0,0 +1,31 @@
+#pragma once
+
+#include <functional>
+
+struct ChunkCoordinate
+{
+    int x, y, z;
+    
+    ChunkCoordinate(int x, int y, int z) : x(x), y(y), z(z) {}
+    
+    bool operator==(const ChunkCoordinate& other) const
+    {
+        return x == other.x && y == other.y && z == other.z;
+    }
+    
+    bool operator<(const ChunkCoordinate& other) const
+    {
+        if (x != other.x) return x < other.x;
+        if (y != other.y) return y < other.y;
+        return z < other.z;
+    }
+};
+
+// Hash function for ChunkCoordinate to use in unordered_set
+struct ChunkCoordinateHash
+{
+    std::size_t operator()(const ChunkCoordinate& coord) const
+    {
+        return std::hash<int>()(coord.x) ^ (std::hash<int>()(coord.y) << 1) ^ (std::hash<int>()(coord.z) << 2);
+    }
+};
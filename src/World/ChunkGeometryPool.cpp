@@ -0,0 +1,167 @@
+#include "ChunkGeometryPool.h"
+#include <algorithm>
+
+// Pages with only a handful of holes aren't worth a GPU copy, however fragmented they look
+static constexpr size_t MIN_FREE_RANGES_TO_COMPACT = 16;
+
+ChunkGeometryPool::ChunkGeometryPool(IRenderDevice* device, IDeviceContext* context, uint32_t verticesPerPage)
+    : m_pDevice(device), m_pContext(context), m_VerticesPerPage(verticesPerPage)
+{
+}
+
+RefCntAutoPtr<IBuffer> ChunkGeometryPool::CreatePageBuffer()
+{
+    BufferDesc pageDesc;
+    pageDesc.Name = "Chunk geometry page";
+    pageDesc.Usage = USAGE_DEFAULT;
+    pageDesc.BindFlags = BIND_VERTEX_BUFFER;
+    pageDesc.Size = static_cast<Uint64>(m_VerticesPerPage) * sizeof(ChunkVertex);
+
+    RefCntAutoPtr<IBuffer> buffer;
+    m_pDevice->CreateBuffer(pageDesc, nullptr, &buffer);
+    return buffer;
+}
+
+GeometryHandle ChunkGeometryPool::Allocate(const ChunkVertex* vertices, uint32_t vertexCount)
+{
+    if (vertexCount == 0 || vertexCount > m_VerticesPerPage)
+        return InvalidGeometryHandle;
+
+    // First page with a large enough hole, otherwise a new page
+    uint32_t page = 0;
+    uint32_t offset = RangeAllocator::InvalidOffset;
+    for (; page < m_Pages.size(); ++page)
+    {
+        offset = m_Pages[page].Allocator.Allocate(vertexCount);
+        if (offset != RangeAllocator::InvalidOffset)
+            break;
+    }
+    if (offset == RangeAllocator::InvalidOffset)
+    {
+        Page newPage;
+        newPage.Buffer = CreatePageBuffer();
+        newPage.Allocator.Reset(m_VerticesPerPage);
+        offset = newPage.Allocator.Allocate(vertexCount);
+        page = static_cast<uint32_t>(m_Pages.size());
+        m_Pages.push_back(std::move(newPage));
+    }
+
+    m_pContext->UpdateBuffer(m_Pages[page].Buffer, static_cast<Uint64>(offset) * sizeof(ChunkVertex),
+                             static_cast<Uint64>(vertexCount) * sizeof(ChunkVertex), vertices,
+                             RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    GeometryHandle handle;
+    if (!m_FreeHandles.empty())
+    {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    }
+    else
+    {
+        handle = static_cast<GeometryHandle>(m_Allocations.size());
+        m_Allocations.emplace_back();
+    }
+    m_Allocations[handle] = GeometryAllocation{page, offset, vertexCount};
+    return handle;
+}
+
+void ChunkGeometryPool::Free(GeometryHandle handle)
+{
+    if (handle == InvalidGeometryHandle)
+        return;
+
+    GeometryAllocation& allocation = m_Allocations[handle];
+    m_Pages[allocation.Page].Allocator.Free(allocation.Offset, allocation.VertexCount);
+    allocation = GeometryAllocation{};
+    m_FreeHandles.push_back(handle);
+}
+
+bool ChunkGeometryPool::CompactIfFragmented(float fragmentationThreshold)
+{
+    // A page just under the threshold would otherwise be recompacted every few frames, each time
+    // holding a second page of VRAM until the copy retires
+    if (m_CallsSinceCompaction < MinCallsBetweenCompactions)
+    {
+        m_CallsSinceCompaction++;
+        return false;
+    }
+
+    uint32_t worstPage = 0;
+    float worstFragmentation = fragmentationThreshold;
+    bool found = false;
+    for (uint32_t page = 0; page < m_Pages.size(); ++page)
+    {
+        const RangeAllocator& allocator = m_Pages[page].Allocator;
+        if (allocator.GetFreeRangeCount() < MIN_FREE_RANGES_TO_COMPACT)
+            continue;
+
+        if (allocator.GetFragmentation() > worstFragmentation)
+        {
+            worstFragmentation = allocator.GetFragmentation();
+            worstPage = page;
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        CompactPage(worstPage);
+        m_CallsSinceCompaction = 0;
+    }
+    return found;
+}
+
+void ChunkGeometryPool::CompactPage(uint32_t page)
+{
+    // Live meshes on this page in address order. Allocations aren't indexed by page, so this walks
+    // every handle; that is cheap next to the GPU copy below.
+    std::vector<GeometryHandle>& liveHandles = m_LiveHandles;
+    liveHandles.clear();
+    for (GeometryHandle handle = 0; handle < m_Allocations.size(); ++handle)
+    {
+        const GeometryAllocation& allocation = m_Allocations[handle];
+        if (allocation.VertexCount > 0 && allocation.Page == page)
+            liveHandles.push_back(handle);
+    }
+    std::sort(liveHandles.begin(), liveHandles.end(), [this](GeometryHandle a, GeometryHandle b) {
+        return m_Allocations[a].Offset < m_Allocations[b].Offset;
+    });
+
+    // Copy them back to back into a fresh buffer; the old one is released once the GPU is done with
+    // it, so until then the page takes twice its size in VRAM
+    RefCntAutoPtr<IBuffer> compacted = CreatePageBuffer();
+    uint32_t nextOffset = 0;
+    for (GeometryHandle handle : liveHandles)
+    {
+        GeometryAllocation& allocation = m_Allocations[handle];
+        m_pContext->CopyBuffer(m_Pages[page].Buffer, static_cast<Uint64>(allocation.Offset) * sizeof(ChunkVertex), RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                               compacted, static_cast<Uint64>(nextOffset) * sizeof(ChunkVertex),
+                               static_cast<Uint64>(allocation.VertexCount) * sizeof(ChunkVertex), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        allocation.Offset = nextOffset;
+        nextOffset += allocation.VertexCount;
+    }
+
+    // The live meshes now form one prefix; the rest of the page is a single free range
+    m_Pages[page].Buffer = compacted;
+    m_Pages[page].Allocator.Reset(m_VerticesPerPage);
+    if (nextOffset > 0)
+        m_Pages[page].Allocator.Allocate(nextOffset);
+
+    m_CompactionCount++;
+}
+
+GeometryPoolStats ChunkGeometryPool::GetStats() const
+{
+    GeometryPoolStats stats;
+    stats.PageCount = m_Pages.size();
+    stats.AllocationCount = m_Allocations.size() - m_FreeHandles.size();
+    stats.CompactionCount = m_CompactionCount;
+    for (const Page& page : m_Pages)
+    {
+        stats.CapacityBytes += static_cast<uint64_t>(page.Allocator.GetCapacity()) * sizeof(ChunkVertex);
+        stats.UsedBytes += static_cast<uint64_t>(page.Allocator.GetUsed()) * sizeof(ChunkVertex);
+        stats.FreeRangeCount += page.Allocator.GetFreeRangeCount();
+        stats.Fragmentation = std::max(stats.Fragmentation, page.Allocator.GetFragmentation());
+    }
+    return stats;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Chunk.h"
+#include "RangeAllocator.h"
+#include "Common/interface/RefCntAutoPtr.hpp"
+#include "Graphics/GraphicsEngine/interface/RenderDevice.h"
+#include "Graphics/GraphicsEngine/interface/DeviceContext.h"
+#include "Graphics/GraphicsEngine/interface/Buffer.h"
+#include <vector>
+
+using namespace Diligent;
+
+// Stable handle to a chunk mesh in the pool; the mesh itself may move during compaction
+using GeometryHandle = uint32_t;
+static constexpr GeometryHandle InvalidGeometryHandle = UINT32_MAX;
+
+// Where a chunk mesh currently lives (offsets and counts are in vertices)
+struct GeometryAllocation
+{
+    uint32_t Page = 0;
+    uint32_t Offset = 0;
+    uint32_t VertexCount = 0;
+};
+
+struct GeometryPoolStats
+{
+    size_t PageCount = 0;
+    size_t AllocationCount = 0;
+    size_t FreeRangeCount = 0;
+    uint64_t CapacityBytes = 0;
+    uint64_t UsedBytes = 0;
+    float Fragmentation = 0.0f;     // Worst page
+    size_t CompactionCount = 0;
+};
+
+// Chunk vertices sub-allocated from a few large vertex buffers ("pages") instead of one
+// buffer per chunk. Pages are added when full, and a page whose free space has splintered
+// is compacted by copying its live meshes into a fresh buffer on the GPU. Until the GPU is done
+// with the old buffer both are alive, so a compaction briefly costs a second page of VRAM;
+// compactions are therefore spaced out rather than run whenever a page crosses the threshold.
+class ChunkGeometryPool
+{
+public:
+    // Default page: 4M vertices (32 MB). No chunk mesh exceeds 16^3 blocks * 6 faces * 4 vertices
+    // (~98K vertices), so a page holds at least 42 of them
+    static constexpr uint32_t DefaultVerticesPerPage = 4u * 1024u * 1024u;
+
+    ChunkGeometryPool(IRenderDevice* device, IDeviceContext* context, uint32_t verticesPerPage = DefaultVerticesPerPage);
+
+    GeometryHandle Allocate(const ChunkVertex* vertices, uint32_t vertexCount);
+    void Free(GeometryHandle handle);
+
+    const GeometryAllocation& GetAllocation(GeometryHandle handle) const { return m_Allocations[handle]; }
+    IBuffer* GetPageBuffer(uint32_t page) const { return m_Pages[page].Buffer; }
+    size_t GetPageCount() const { return m_Pages.size(); }
+
+    // Compacts the most fragmented page if it is above the threshold; at most one page per call,
+    // and none within MinCallsBetweenCompactions calls of the last compaction
+    bool CompactIfFragmented(float fragmentationThreshold = 0.5f);
+
+    static constexpr size_t MinCallsBetweenCompactions = 120;
+
+    GeometryPoolStats GetStats() const;
+
+private:
+    struct Page
+    {
+        RefCntAutoPtr<IBuffer> Buffer;
+        RangeAllocator Allocator;
+    };
+
+    RefCntAutoPtr<IBuffer> CreatePageBuffer();
+    void CompactPage(uint32_t page);
+
+    IRenderDevice* m_pDevice;
+    IDeviceContext* m_pContext;
+    uint32_t m_VerticesPerPage;
+
+    std::vector<Page> m_Pages;
+    std::vector<GeometryAllocation> m_Allocations;   // Indexed by handle
+    std::vector<GeometryHandle> m_FreeHandles;
+    std::vector<GeometryHandle> m_LiveHandles;       // CompactPage scratch
+    size_t m_CompactionCount = 0;
+    size_t m_CallsSinceCompaction = MinCallsBetweenCompactions;
+};
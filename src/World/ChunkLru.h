@@ -0,0 +1,128 @@
+#pragma once
+
+#include "ChunkMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Least-recently-used list keyed by chunk key, for the caches of unloaded chunks and terrain
+// columns. The list is intrusive: entries live in one vector and link to each other by index,
+// a ChunkMap finds them by key, and removed entries are reused, so once the list has held its
+// peak number of entries inserting, touching and removing no longer allocate.
+template <typename T>
+class ChunkLru
+{
+public:
+    T* Find(int64_t key)
+    {
+        const uint32_t* index = m_Lookup.Find(key);
+        return index != nullptr ? &m_Entries[*index].Value : nullptr;
+    }
+
+    const T* Find(int64_t key) const { return const_cast<ChunkLru*>(this)->Find(key); }
+
+    // Find and mark most recently used
+    T* Touch(int64_t key)
+    {
+        const uint32_t* index = m_Lookup.Find(key);
+        if (index == nullptr)
+            return nullptr;
+        Unlink(*index);
+        LinkFront(*index);
+        return &m_Entries[*index].Value;
+    }
+
+    // Adds a default value as the most recently used; the key must not be present
+    T& Insert(int64_t key)
+    {
+        uint32_t index = m_FreeList;
+        if (index != NoEntry)
+        {
+            m_FreeList = m_Entries[index].Next;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_Entries.size());
+            m_Entries.emplace_back();
+        }
+
+        m_Entries[index].Key = key;
+        m_Lookup[key] = index;
+        LinkFront(index);
+        return m_Entries[index].Value;
+    }
+
+    // The key must be present
+    T Remove(int64_t key) { return RemoveEntry(*m_Lookup.Find(key)); }
+
+    // The list must not be empty
+    T RemoveOldest() { return RemoveEntry(m_Tail); }
+
+    void Clear()
+    {
+        while (m_Tail != NoEntry)
+        {
+            RemoveEntry(m_Tail);
+        }
+    }
+
+    size_t Size() const { return m_Lookup.Size(); }
+    bool Empty() const { return m_Lookup.Empty(); }
+
+private:
+    static constexpr uint32_t NoEntry = UINT32_MAX;
+
+    struct Entry
+    {
+        int64_t Key = 0;
+        T Value{};
+        uint32_t Prev = NoEntry;
+        uint32_t Next = NoEntry;    // Next free entry while on the free list
+    };
+
+    void LinkFront(uint32_t index)
+    {
+        Entry& entry = m_Entries[index];
+        entry.Prev = NoEntry;
+        entry.Next = m_Head;
+        if (m_Head != NoEntry)
+            m_Entries[m_Head].Prev = index;
+        else
+            m_Tail = index;
+        m_Head = index;
+    }
+
+    void Unlink(uint32_t index)
+    {
+        Entry& entry = m_Entries[index];
+        if (entry.Prev != NoEntry)
+            m_Entries[entry.Prev].Next = entry.Next;
+        else
+            m_Head = entry.Next;
+        if (entry.Next != NoEntry)
+            m_Entries[entry.Next].Prev = entry.Prev;
+        else
+            m_Tail = entry.Prev;
+    }
+
+    T RemoveEntry(uint32_t index)
+    {
+        Unlink(index);
+
+        Entry& entry = m_Entries[index];
+        m_Lookup.Erase(entry.Key);
+        T value = std::move(entry.Value);
+        entry.Value = T{};
+        entry.Prev = NoEntry;
+        entry.Next = m_FreeList;
+        m_FreeList = index;
+        return value;
+    }
+
+    std::vector<Entry> m_Entries;
+    ChunkMap<uint32_t> m_Lookup;    // Key to entry index
+    uint32_t m_Head = NoEntry;      // Most recently used
+    uint32_t m_Tail = NoEntry;      // Least recently used
+    uint32_t m_FreeList = NoEntry;
+};
@@ -1,13 +1,84 @@
 #include "ChunkManager.h"
+#include "../Core/Profiler.h"
 #include "Graphics/GraphicsEngine/interface/GraphicsTypes.h"
+#include "Graphics/GraphicsTools/interface/MapHelper.hpp"
+#include <algorithm>
+#include <chrono>
 
 ChunkManager::ChunkManager(IRenderDevice* device, IDeviceContext* context)
     : m_pDevice(device), m_pContext(context)
 {
+    // Native multi-draw indirect needs the first-instance argument honoured for the chunk origins
+    const DRAW_COMMAND_CAP_FLAGS drawCaps = m_pDevice->GetAdapterInfo().DrawCommand.CapFlags;
+    m_MultiDrawIndirectSupported = (drawCaps & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT) != 0 &&
+                                   (drawCaps & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_FIRST_INSTANCE) != 0;
+    
+    CreateQuadIndexBuffer();
+    ReserveDrawBuffers(4096);
+    m_GeometryPool = std::make_unique<ChunkGeometryPool>(m_pDevice, m_pContext);
+}
+
+void ChunkManager::CreateQuadIndexBuffer()
+{
+    // Every chunk mesh is a quad list, so one preallocated index buffer covers them all
+    std::vector<uint32_t> indices(static_cast<size_t>(MAX_QUADS_PER_CHUNK) * INDICES_PER_QUAD);
+    for (uint32_t quad = 0; quad < static_cast<uint32_t>(MAX_QUADS_PER_CHUNK); ++quad)
+    {
+        uint32_t* quadIndices = &indices[static_cast<size_t>(quad) * INDICES_PER_QUAD];
+        uint32_t baseVertex = quad * 4;
+        quadIndices[0] = baseVertex;
+        quadIndices[1] = baseVertex + 1;
+        quadIndices[2] = baseVertex + 2;
+        quadIndices[3] = baseVertex + 2;
+        quadIndices[4] = baseVertex + 3;
+        quadIndices[5] = baseVertex;
+    }
+    
+    BufferDesc indexBufferDesc;
+    indexBufferDesc.Name = "Shared quad index buffer";
+    indexBufferDesc.Usage = USAGE_IMMUTABLE;
+    indexBufferDesc.BindFlags = BIND_INDEX_BUFFER;
+    indexBufferDesc.Size = indices.size() * sizeof(uint32_t);
+    
+    BufferData indexData;
+    indexData.pData = indices.data();
+    indexData.DataSize = indexBufferDesc.Size;
+    
+    m_pDevice->CreateBuffer(indexBufferDesc, &indexData, &m_pQuadIndexBuffer);
+}
+
+void ChunkManager::ReserveDrawBuffers(size_t drawCount)
+{
+    if (drawCount <= m_DrawCapacity)
+        return;
+    
+    // Grow geometrically so a slowly growing visible set doesn't recreate the buffers every frame
+    m_DrawCapacity = std::max(drawCount, m_DrawCapacity * 2);
+    
+    BufferDesc instanceDesc;
+    instanceDesc.Name = "Chunk instance buffer";
+    instanceDesc.Usage = USAGE_DYNAMIC;
+    instanceDesc.BindFlags = BIND_VERTEX_BUFFER;
+    instanceDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    instanceDesc.Size = m_DrawCapacity * sizeof(float4);
+    m_pInstanceBuffer.Release();
+    m_pDevice->CreateBuffer(instanceDesc, nullptr, &m_pInstanceBuffer);
+    
+    if (m_MultiDrawIndirectSupported)
+    {
+        BufferDesc argsDesc;
+        argsDesc.Name = "Chunk indirect draw args";
+        argsDesc.Usage = USAGE_DEFAULT;
+        argsDesc.BindFlags = BIND_INDIRECT_DRAW_ARGS;
+        argsDesc.Size = m_DrawCapacity * sizeof(DrawIndexedIndirectArgs);
+        m_pIndirectArgsBuffer.Release();
+        m_pDevice->CreateBuffer(argsDesc, nullptr, &m_pIndirectArgsBuffer);
+    }
 }
 
 void ChunkManager::RenderChunks(VoxelWorld* world, Camera* camera, IPipelineState* pso, IShaderResourceBinding* srb)
 {
+    PROFILE_SCOPE("ChunkManager::RenderChunks");
     if (!world || !camera || !pso || !srb)
         return;
     
@@ -15,111 +86,237 @@ void ChunkManager::RenderChunks(VoxelWorld* world, Camera* camera, IPipelineStat
     m_pContext->SetPipelineState(pso);
     m_pContext->CommitShaderResources(srb, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     
-    // Render all loaded chunks
-    for (auto& [key, renderData] : m_ChunkRenderData)
+    // All chunks share the same quad index buffer
+    m_pContext->SetIndexBuffer(m_pQuadIndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    
+    // Cull against the camera frustum, then draw only the chunks that survived
+    auto cullStart = std::chrono::high_resolution_clock::now();
+    m_VisibleChunks.clear();
+    if (m_FrustumCullingEnabled)
+    {
+        m_ChunkBounds.Cull(Frustum::FromViewProjection(camera->GetViewProjectionMatrix()), m_VisibleChunks);
+    }
+    else
     {
-        if (renderData.IndexCount == 0 || !renderData.VertexBuffer || !renderData.IndexBuffer)
+        for (size_t i = 0; i < m_ChunkBounds.Size(); ++i)
+            m_VisibleChunks.push_back(static_cast<uint32_t>(i));
+    }
+    auto cullEnd = std::chrono::high_resolution_clock::now();
+    
+    m_CullingStats.VisibleChunks = m_VisibleChunks.size();
+    m_CullingStats.CulledChunks = m_ChunkBounds.Size() - m_VisibleChunks.size();
+    m_CullingStats.CullTimeMs = std::chrono::duration<double, std::milli>(cullEnd - cullStart).count();
+    
+    // Build the draw list, grouped by pool page so each page is bound once
+    m_Draws.clear();
+    for (uint32_t boundsIndex : m_VisibleChunks)
+    {
+        const ChunkRenderData& renderData = m_ChunkRenderData[boundsIndex];
+        if (renderData.IndexCount == 0 || renderData.Geometry == InvalidGeometryHandle)
             continue;
-            
-        // Set vertex and index buffers
-        IBuffer* vertexBuffers[] = { renderData.VertexBuffer };
-        m_pContext->SetVertexBuffers(0, 1, vertexBuffers, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
-        m_pContext->SetIndexBuffer(renderData.IndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
         
-        // Draw indexed
-        DrawIndexedAttribs drawAttrs;
-        drawAttrs.IndexType = VT_UINT32;
-        drawAttrs.NumIndices = static_cast<Uint32>(renderData.IndexCount);
-        m_pContext->DrawIndexed(drawAttrs);
+        const GeometryAllocation& geometry = m_GeometryPool->GetAllocation(renderData.Geometry);
+        m_Draws.push_back(ChunkDraw{geometry.Page, static_cast<uint32_t>(renderData.IndexCount), geometry.Offset, renderData.Origin});
+    }
+    std::sort(m_Draws.begin(), m_Draws.end(), [](const ChunkDraw& a, const ChunkDraw& b) { return a.Page < b.Page; });
+    
+    m_DrawStats = ChunkDrawStats{};
+    m_DrawStats.MultiDrawIndirect = m_MultiDrawIndirectSupported && m_MultiDrawIndirectEnabled;
+    if (m_Draws.empty())
+        return;
+    
+    // Chunk origins for the whole frame in one upload; draw i reads instance i
+    ReserveDrawBuffers(m_Draws.size());
+    {
+        MapHelper<float4> instanceData(m_pContext, m_pInstanceBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+        for (size_t i = 0; i < m_Draws.size(); ++i)
+            instanceData[i] = m_Draws[i].Origin;
+    }
+    
+    if (m_DrawStats.MultiDrawIndirect)
+    {
+        m_IndirectArgs.resize(m_Draws.size());
+        for (size_t i = 0; i < m_Draws.size(); ++i)
+            m_IndirectArgs[i] = DrawIndexedIndirectArgs{m_Draws[i].IndexCount, 1, 0, m_Draws[i].BaseVertex, static_cast<Uint32>(i)};
+        m_pContext->UpdateBuffer(m_pIndirectArgsBuffer, 0, m_IndirectArgs.size() * sizeof(DrawIndexedIndirectArgs), m_IndirectArgs.data(),
+                                 RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+    
+    for (size_t first = 0; first < m_Draws.size();)
+    {
+        // Range of draws sharing this page
+        const uint32_t page = m_Draws[first].Page;
+        size_t last = first;
+        while (last < m_Draws.size() && m_Draws[last].Page == page)
+            ++last;
+        
+        IBuffer* vertexBuffers[] = { m_GeometryPool->GetPageBuffer(page), m_pInstanceBuffer };
+        m_pContext->SetVertexBuffers(0, 2, vertexBuffers, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+        m_DrawStats.VertexBufferBinds++;
+        
+        if (m_DrawStats.MultiDrawIndirect)
+        {
+            DrawIndexedIndirectAttribs indirectAttrs;
+            indirectAttrs.pAttribsBuffer = m_pIndirectArgsBuffer;
+            indirectAttrs.DrawArgsOffset = first * sizeof(DrawIndexedIndirectArgs);
+            indirectAttrs.DrawArgsStride = sizeof(DrawIndexedIndirectArgs);
+            indirectAttrs.DrawCount = static_cast<Uint32>(last - first);
+            indirectAttrs.IndexType = VT_UINT32;
+            indirectAttrs.AttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            m_pContext->DrawIndexedIndirect(indirectAttrs);
+            m_DrawStats.DrawCalls++;
+        }
+        else
+        {
+            // Base-vertex draws: no state changes between chunks on the same page
+            for (size_t i = first; i < last; ++i)
+            {
+                DrawIndexedAttribs drawAttrs;
+                drawAttrs.IndexType = VT_UINT32;
+                drawAttrs.NumIndices = m_Draws[i].IndexCount;
+                drawAttrs.BaseVertex = m_Draws[i].BaseVertex;
+                drawAttrs.FirstInstanceLocation = static_cast<Uint32>(i);
+                m_pContext->DrawIndexed(drawAttrs);
+            }
+            m_DrawStats.DrawCalls += last - first;
+        }
+        
+        first = last;
     }
 }
 
 void ChunkManager::UpdateChunkBuffers(VoxelWorld* world)
 {
+    PROFILE_SCOPE("ChunkManager::UpdateChunkBuffers");
     if (!world)
         return;
     
-    // Get the loaded chunks from the voxel world
-    const auto& loadedChunks = world->GetLoadedChunks();
+    // Only chunks that were loaded, remeshed or unloaded since the last frame are touched.
+    // Events the streaming budget can't cover this frame stay queued, in order, for the next one.
+    size_t previouslyPending = m_ChunkEvents.size();
+    world->DrainChunkEvents(m_ChunkEvents);
+    
+    m_LifecycleStats.EventsLastFrame = m_ChunkEvents.size() - previouslyPending;
+    m_LifecycleStats.UploadsLastFrame = 0;
     
-    for (const auto& [chunkKey, chunk] : loadedChunks)
+    StreamingBudget& budget = world->GetStreamingBudget();
+    size_t eventIndex = 0;
+    for (; eventIndex < m_ChunkEvents.size(); ++eventIndex)
     {
-        if (!chunk)
-            continue;
+        const ChunkEvent& event = m_ChunkEvents[eventIndex];
+        int64_t chunkKey = GetChunkKey(event.Coord.x, event.Coord.y, event.Coord.z);
         
-        int chunkX = chunk->GetChunkX();
-        int chunkY = chunk->GetChunkY();
-        int chunkZ = chunk->GetChunkZ();
-        
-        // Generate mesh if needed
-        if (chunk->IsDirty())
+        // Departed chunks hand their vertices back to the pool
+        if (event.Type == ChunkEventType::Unloaded)
         {
-            chunk->BuildMesh(world);
+            if (!budget.HasBudget(StreamingOp::Unload))
+                break;
+            auto releaseStart = StreamingBudget::Clock::now();
+            RemoveRenderData(chunkKey);
+            budget.Record(StreamingOp::Unload, releaseStart);
+            m_LifecycleStats.Unloads++;
+            continue;
         }
         
-        // Get or create render data for this chunk
-        ChunkRenderData& renderData = m_ChunkRenderData[chunkKey];
+        // Loaded chunks are meshed once their neighbors are in; a Remeshed event follows
+        Chunk* chunk = world->FindChunk(chunkKey);
+        if (event.Type == ChunkEventType::Loaded && chunk != nullptr && !chunk->IsMeshBuilt())
+            continue;
         
-        // Create GPU buffers if mesh was built and we need to update
-        if (chunk->IsMeshBuilt() && (renderData.NeedsUpdate || !renderData.VertexBuffer))
+        // Remeshed again (or unloaded) after this event was queued: a newer event covers it
+        if (chunk == nullptr || !chunk->IsMeshBuilt() || event.MeshVersion != chunk->GetMeshVersion())
         {
-            CreateChunkBuffers(chunk.get(), renderData);
+            m_LifecycleStats.StaleEventsSkipped++;
+            continue;
         }
+        
+        // Chunks without geometry (e.g. uniform air/solid) never get GPU buffers
+        if (chunk->GetIndexCount() == 0)
+        {
+            RemoveRenderData(chunkKey);
+            continue;
         }
+        
+        if (!budget.HasBudget(StreamingOp::Upload))
+            break;
+        auto uploadStart = StreamingBudget::Clock::now();
+        ChunkRenderData& renderData = GetOrCreateRenderData(chunkKey, *chunk);
+        CreateChunkBuffers(chunk, renderData);
+        budget.Record(StreamingOp::Upload, uploadStart);
+        m_LifecycleStats.UploadsLastFrame++;
     }
+    m_ChunkEvents.erase(m_ChunkEvents.begin(), m_ChunkEvents.begin() + eventIndex);
+    
+    // Streaming leaves holes in the pool; squeeze out the worst page once it gets splintered
+    m_GeometryPool->CompactIfFragmented();
+}
+
+ChunkRenderData& ChunkManager::GetOrCreateRenderData(int64_t key, const Chunk& chunk)
+{
+    if (const uint32_t* slot = m_RenderDataIndex.Find(key))
+        return m_ChunkRenderData[*slot];
+    
+    // Chunks never move, so their bounds are registered once
+    int3 worldPosition = chunk.GetWorldPosition();
+    float3 boundsMin(static_cast<float>(worldPosition.x), static_cast<float>(worldPosition.y), static_cast<float>(worldPosition.z));
+    float3 boundsMax = boundsMin + float3(static_cast<float>(CHUNK_X_SIZE), static_cast<float>(CHUNK_Y_SIZE), static_cast<float>(CHUNK_Z_SIZE));
+    
+    size_t slot = m_ChunkBounds.Add(boundsMin, boundsMax);
+    m_RenderDataIndex[key] = static_cast<uint32_t>(slot);
+    m_ChunkRenderData.emplace_back();
+    m_ChunkRenderData[slot].Key = key;
+    return m_ChunkRenderData[slot];
+}
+
+void ChunkManager::RemoveRenderData(int64_t key)
+{
+    const uint32_t* found = m_RenderDataIndex.Find(key);
+    if (found == nullptr)
+        return;
+    
+    // Swap the last slot into the freed one, in both arrays, and re-index the chunk that moved
+    uint32_t slot = *found;
+    m_RenderDataIndex.Erase(key);
+    m_GeometryPool->Free(m_ChunkRenderData[slot].Geometry);
+    
+    m_ChunkBounds.RemoveSwap(slot);
+    m_ChunkRenderData[slot] = m_ChunkRenderData.back();
+    m_ChunkRenderData.pop_back();
+    if (slot < m_ChunkRenderData.size())
+        m_RenderDataIndex[m_ChunkRenderData[slot].Key] = slot;
+}
 
 void ChunkManager::CreateChunkBuffers(Chunk* chunk, ChunkRenderData& renderData)
 {
+    PROFILE_SCOPE("ChunkManager::CreateChunkBuffers");
     if (!chunk || !chunk->IsMeshBuilt())
     {
         return;
     }
     
     const auto& vertices = chunk->GetVertices();
-    const auto& indices = chunk->GetIndices();
     
-    if (vertices.empty() || indices.empty())
+    if (vertices.empty())
     {
+        m_GeometryPool->Free(renderData.Geometry);
+        renderData.Geometry = InvalidGeometryHandle;
         renderData.IndexCount = 0;
         return;
     }
     
-    // Create vertex buffer
-    BufferDesc vertexBufferDesc;
-    vertexBufferDesc.Name = "Chunk vertex buffer";
-    vertexBufferDesc.Usage = USAGE_IMMUTABLE;
-    vertexBufferDesc.BindFlags = BIND_VERTEX_BUFFER;
-    vertexBufferDesc.Size = vertices.size() * sizeof(float);
-    
-    BufferData vertexData;
-    vertexData.pData = vertices.data();
-    vertexData.DataSize = vertexBufferDesc.Size;
-    
-    m_pDevice->CreateBuffer(vertexBufferDesc, &vertexData, &renderData.VertexBuffer);
-    
-    // Create index buffer
-    BufferDesc indexBufferDesc;
-    indexBufferDesc.Name = "Chunk index buffer";
-    indexBufferDesc.Usage = USAGE_IMMUTABLE;
-    indexBufferDesc.BindFlags = BIND_INDEX_BUFFER;
-    indexBufferDesc.Size = indices.size() * sizeof(uint32_t);
-    
-    BufferData indexData;
-    indexData.pData = indices.data();
-    indexData.DataSize = indexBufferDesc.Size;
-    
-    m_pDevice->CreateBuffer(indexBufferDesc, &indexData, &renderData.IndexBuffer);
+    // Replace the previous mesh in the geometry pool (indices come from the shared quad index buffer)
+    m_GeometryPool->Free(renderData.Geometry);
+    renderData.Geometry = m_GeometryPool->Allocate(vertices.data(), static_cast<uint32_t>(vertices.size()));
     
-    renderData.IndexCount = indices.size();
-    renderData.NeedsUpdate = false;
+    int3 worldPosition = chunk->GetWorldPosition();
+    renderData.Origin = float4(static_cast<float>(worldPosition.x), static_cast<float>(worldPosition.y), static_cast<float>(worldPosition.z), 0.0f);
+    renderData.IndexCount = chunk->GetIndexCount();
+    renderData.MeshVersion = chunk->GetMeshVersion();
     
     // Removed console output for performance
 }
 
 int64_t ChunkManager::GetChunkKey(int chunkX, int chunkY, int chunkZ) const
 {
-    // Create a 64-bit key from 3D coordinates (21 bits each, with some overflow protection)
-    return (static_cast<int64_t>(chunkX & 0x1FFFFF) << 42) | 
-           (static_cast<int64_t>(chunkY & 0x1FFFFF) << 21) | 
-           (static_cast<int64_t>(chunkZ & 0x1FFFFF));
+    return MakeChunkKey(chunkX, chunkY, chunkZ);
 }
\ No newline at end of file
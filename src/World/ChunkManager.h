@@ -1,21 +1,50 @@
 #pragma once
 
 #include "VoxelWorld.h"
+#include "ChunkGeometryPool.h"
 #include "../Rendering/Camera.h"
+#include "../Rendering/FrustumCuller.h"
 #include "Common/interface/RefCntAutoPtr.hpp"
 #include "Graphics/GraphicsEngine/interface/RenderDevice.h"
 #include "Graphics/GraphicsEngine/interface/DeviceContext.h"
 #include "Graphics/GraphicsEngine/interface/Buffer.h"
-#include <unordered_map>
+#include <memory>
+#include <vector>
 
 using namespace Diligent;
 
 struct ChunkRenderData
 {
-    RefCntAutoPtr<IBuffer> VertexBuffer;
-    RefCntAutoPtr<IBuffer> IndexBuffer;
-    size_t IndexCount = 0;
-    bool NeedsUpdate = true;
+    int64_t Key = 0;            // Chunk key, to re-index the entry when it changes slot
+    GeometryHandle Geometry = InvalidGeometryHandle;   // Vertices in the shared geometry pool
+    size_t IndexCount = 0;      // Indices drawn from the shared quad index buffer
+    float4 Origin;              // Chunk world position, supplied to the shader as instance data
+    uint32_t MeshVersion = 0;   // Chunk mesh version currently uploaded
+};
+
+// Frustum culling results of the last RenderChunks call
+struct ChunkCullingStats
+{
+    size_t VisibleChunks = 0;
+    size_t CulledChunks = 0;
+    double CullTimeMs = 0.0;
+};
+
+// Chunk lifecycle events handled by UpdateChunkBuffers
+struct ChunkLifecycleStats
+{
+    size_t EventsLastFrame = 0;
+    size_t UploadsLastFrame = 0;
+    size_t StaleEventsSkipped = 0;
+    size_t Unloads = 0;
+};
+
+// Submission cost of the last RenderChunks call
+struct ChunkDrawStats
+{
+    size_t DrawCalls = 0;           // API draw calls (one per page with multi-draw indirect)
+    size_t VertexBufferBinds = 0;
+    bool MultiDrawIndirect = false;
 };
 
 class ChunkManager
@@ -25,14 +54,77 @@ public:
     ~ChunkManager() = default;
     
     void RenderChunks(VoxelWorld* world, Camera* camera, IPipelineState* pso, IShaderResourceBinding* srb);
+    
+    // Applies the world's chunk events: uploads new meshes and releases unloaded chunks
+    // within the world's streaming budget
     void UpdateChunkBuffers(VoxelWorld* world);
+    const ChunkLifecycleStats& GetLifecycleStats() const { return m_LifecycleStats; }
+    size_t GetPendingEventCount() const { return m_ChunkEvents.size(); }
+    
+    // Frustum culling
+    void SetFrustumCullingEnabled(bool enabled) { m_FrustumCullingEnabled = enabled; }
+    bool IsFrustumCullingEnabled() const { return m_FrustumCullingEnabled; }
+    const ChunkCullingStats& GetCullingStats() const { return m_CullingStats; }
+    
+    // Chunk vertex buffer pool
+    GeometryPoolStats GetGeometryPoolStats() const { return m_GeometryPool->GetStats(); }
+    
+    // Draw submission
+    bool IsMultiDrawIndirectSupported() const { return m_MultiDrawIndirectSupported; }
+    void SetMultiDrawIndirectEnabled(bool enabled) { m_MultiDrawIndirectEnabled = enabled; }
+    bool IsMultiDrawIndirectEnabled() const { return m_MultiDrawIndirectEnabled; }
+    const ChunkDrawStats& GetDrawStats() const { return m_DrawStats; }
     
 private:
     IRenderDevice* m_pDevice;
     IDeviceContext* m_pContext;
+    RefCntAutoPtr<IBuffer> m_pQuadIndexBuffer;  // Shared by all chunks
+    std::unique_ptr<ChunkGeometryPool> m_GeometryPool;
+    
+    std::vector<ChunkEvent> m_ChunkEvents;     // Drained but not yet applied
+    ChunkLifecycleStats m_LifecycleStats;
+    
+    // Render data and culling bounds in parallel dense arrays (slot i of one belongs to slot i
+    // of the other), with the chunk key index pointing at each chunk's slot. The index can't live
+    // in the world's chunk entries: unload events are applied after the chunk has left the world,
+    // and a swap-removal re-indexes a slot whose chunk may already be gone.
+    std::vector<ChunkRenderData> m_ChunkRenderData;
+    AABBArray m_ChunkBounds;
+    ChunkMap<uint32_t> m_RenderDataIndex;
+    std::vector<uint32_t> m_VisibleChunks;
+    bool m_FrustumCullingEnabled = true;
+    ChunkCullingStats m_CullingStats;
     
-    std::unordered_map<int64_t, ChunkRenderData> m_ChunkRenderData;
+    // Per-frame draw list: chunk origins go to the instance buffer, one instance per draw,
+    // and with multi-draw indirect the draw arguments are uploaded as well
+    struct ChunkDraw
+    {
+        uint32_t Page;
+        uint32_t IndexCount;
+        uint32_t BaseVertex;
+        float4 Origin;
+    };
+    struct DrawIndexedIndirectArgs
+    {
+        Uint32 NumIndices;
+        Uint32 NumInstances;
+        Uint32 FirstIndexLocation;
+        Uint32 BaseVertex;
+        Uint32 FirstInstanceLocation;
+    };
+    std::vector<ChunkDraw> m_Draws;
+    std::vector<DrawIndexedIndirectArgs> m_IndirectArgs;
+    RefCntAutoPtr<IBuffer> m_pInstanceBuffer;
+    RefCntAutoPtr<IBuffer> m_pIndirectArgsBuffer;
+    size_t m_DrawCapacity = 0;
+    bool m_MultiDrawIndirectSupported = false;
+    bool m_MultiDrawIndirectEnabled = true;
+    ChunkDrawStats m_DrawStats;
     
+    void CreateQuadIndexBuffer();
+    void ReserveDrawBuffers(size_t drawCount);
+    ChunkRenderData& GetOrCreateRenderData(int64_t key, const Chunk& chunk);
+    void RemoveRenderData(int64_t key);
     void CreateChunkBuffers(Chunk* chunk, ChunkRenderData& renderData);
     int64_t GetChunkKey(int chunkX, int chunkY, int chunkZ) const;
 };
\ No newline at end of file
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "ChunkCoordinate.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Packs chunk coordinates into a 63-bit key (21 bits per axis), so keys are never negative
+inline int64_t MakeChunkKey(int chunkX, int chunkY, int chunkZ)
+{
+    return (static_cast<int64_t>(chunkX & 0x1FFFFF) << 42) |
+           (static_cast<int64_t>(chunkY & 0x1FFFFF) << 21) |
+           (static_cast<int64_t>(chunkZ & 0x1FFFFF));
+}
+
+// Inverse of MakeChunkKey: sign-extends each 21-bit field back to a coordinate
+inline ChunkCoordinate ChunkKeyToCoordinate(int64_t key)
+{
+    auto axis = [key](int shift) { return static_cast<int32_t>(static_cast<uint32_t>((key >> shift) & 0x1FFFFF) << 11) >> 11; };
+    return ChunkCoordinate(axis(42), axis(21), axis(0));
+}
+
+// Flat open-addressing hash map from chunk key to a small value (a chunk handle or a slot index).
+// Keys and values live inline in one power-of-two slot array with linear probing, so a lookup is
+// a hash and a short scan of adjacent slots, with no node allocation or pointer chase.
+// The table stays at most half full; erasing shifts the rest of the probe run back instead of
+// leaving tombstones. Values move when the table grows or an entry is erased, so don't hold
+// pointers to them across inserts or erases.
+template <typename T>
+class ChunkMap
+{
+public:
+    struct Slot
+    {
+        int64_t Key = EmptyKey;
+        T Value{};
+    };
+
+    // Iterates occupied slots; binds as `auto& [key, value]`
+    template <typename SlotType>
+    class Iterator
+    {
+    public:
+        Iterator(SlotType* slot, SlotType* end) : m_Slot(slot), m_End(end) { SkipEmpty(); }
+
+        SlotType& operator*() const { return *m_Slot; }
+        SlotType* operator->() const { return m_Slot; }
+        Iterator& operator++() { ++m_Slot; SkipEmpty(); return *this; }
+        bool operator!=(const Iterator& other) const { return m_Slot != other.m_Slot; }
+        bool operator==(const Iterator& other) const { return m_Slot == other.m_Slot; }
+
+    private:
+        void SkipEmpty()
+        {
+            while (m_Slot != m_End && m_Slot->Key == EmptyKey)
+                ++m_Slot;
+        }
+
+        SlotType* m_Slot;
+        SlotType* m_End;
+    };
+
+    T* Find(int64_t key)
+    {
+        if (m_Size == 0)
+            return nullptr;
+        for (size_t index = GetHomeSlot(key);; index = (index + 1) & m_Mask)
+        {
+            Slot& slot = m_Slots[index];
+            if (slot.Key == key)
+                return &slot.Value;
+            if (slot.Key == EmptyKey)
+                return nullptr;
+        }
+    }
+
+    const T* Find(int64_t key) const { return const_cast<ChunkMap*>(this)->Find(key); }
+    bool Contains(int64_t key) const { return Find(key) != nullptr; }
+
+    // Inserts a default value if the key is missing
+    T& operator[](int64_t key)
+    {
+        if ((m_Size + 1) * 2 > m_Slots.size())
+            Grow();
+
+        size_t index = GetHomeSlot(key);
+        while (m_Slots[index].Key != EmptyKey)
+        {
+            if (m_Slots[index].Key == key)
+                return m_Slots[index].Value;
+            index = (index + 1) & m_Mask;
+        }
+        m_Slots[index].Key = key;
+        m_Size++;
+        return m_Slots[index].Value;
+    }
+
+    bool Erase(int64_t key)
+    {
+        if (m_Size == 0)
+            return false;
+
+        size_t index = GetHomeSlot(key);
+        while (m_Slots[index].Key != key)
+        {
+            if (m_Slots[index].Key == EmptyKey)
+                return false;
+            index = (index + 1) & m_Mask;
+        }
+
+        // Backward-shift deletion: pull later entries of the run into the hole unless that
+        // would move them in front of their home slot
+        size_t hole = index;
+        for (size_t next = (hole + 1) & m_Mask; m_Slots[next].Key != EmptyKey; next = (next + 1) & m_Mask)
+        {
+            size_t home = GetHomeSlot(m_Slots[next].Key);
+            if (((next - home) & m_Mask) >= ((next - hole) & m_Mask))
+            {
+                m_Slots[hole] = std::move(m_Slots[next]);
+                hole = next;
+            }
+        }
+        m_Slots[hole].Key = EmptyKey;
+        m_Slots[hole].Value = T{};
+        m_Size--;
+        return true;
+    }
+
+    // Empties the table but keeps its capacity, so refilling it does not allocate
+    void Clear()
+    {
+        if (m_Size == 0)
+            return;
+        for (Slot& slot : m_Slots)
+            slot = Slot{};
+        m_Size = 0;
+    }
+
+    size_t Size() const { return m_Size; }
+    bool Empty() const { return m_Size == 0; }
+    size_t GetCapacity() const { return m_Slots.size(); }
+
+    Iterator<Slot> begin() { return Iterator<Slot>(m_Slots.data(), m_Slots.data() + m_Slots.size()); }
+    Iterator<Slot> end() { return Iterator<Slot>(m_Slots.data() + m_Slots.size(), m_Slots.data() + m_Slots.size()); }
+    Iterator<const Slot> begin() const { return Iterator<const Slot>(m_Slots.data(), m_Slots.data() + m_Slots.size()); }
+    Iterator<const Slot> end() const { return Iterator<const Slot>(m_Slots.data() + m_Slots.size(), m_Slots.data() + m_Slots.size()); }
+
+private:
+    static constexpr int64_t EmptyKey = -1;
+    static constexpr size_t MinCapacity = 64;
+
+    size_t GetHomeSlot(int64_t key) const
+    {
+        // Fibonacci hashing: the top bits of the product depend on every axis of the packed key
+        return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> m_Shift);
+    }
+
+    void Grow()
+    {
+        std::vector<Slot> oldSlots = std::move(m_Slots);
+        m_Slots = std::vector<Slot>(oldSlots.empty() ? MinCapacity : oldSlots.size() * 2);
+        m_Mask = m_Slots.size() - 1;
+        m_Shift = 64;
+        for (size_t capacity = m_Slots.size(); capacity > 1; capacity >>= 1)
+            m_Shift--;
+        for (Slot& slot : oldSlots)
+        {
+            if (slot.Key == EmptyKey)
+                continue;
+            size_t index = GetHomeSlot(slot.Key);
+            while (m_Slots[index].Key != EmptyKey)
+                index = (index + 1) & m_Mask;
+            m_Slots[index] = std::move(slot);
+        }
+    }
+
+    std::vector<Slot> m_Slots;
+    size_t m_Mask = 0;
+    int m_Shift = 64;
+    size_t m_Size = 0;
+};
+
+// Set of chunk coordinates on a ChunkMap, for streaming bookkeeping that would otherwise allocate
+// a node per insert. Iterating yields the coordinates; don't insert or erase while iterating.
+class ChunkSet
+{
+public:
+    using Map = ChunkMap<uint8_t>;
+
+    class Iterator
+    {
+    public:
+        explicit Iterator(Map::Iterator<const Map::Slot> slot) : m_Slot(slot) {}
+
+        ChunkCoordinate operator*() const { return ChunkKeyToCoordinate(m_Slot->Key); }
+        Iterator& operator++() { ++m_Slot; return *this; }
+        bool operator!=(const Iterator& other) const { return m_Slot != other.m_Slot; }
+
+    private:
+        Map::Iterator<const Map::Slot> m_Slot;
+    };
+
+    // False if the coordinate was already in the set
+    bool Insert(const ChunkCoordinate& coord)
+    {
+        const size_t size = m_Chunks.Size();
+        m_Chunks[GetKey(coord)] = 1;
+        return m_Chunks.Size() != size;
+    }
+
+    bool Erase(const ChunkCoordinate& coord) { return m_Chunks.Erase(GetKey(coord)); }
+    bool Contains(const ChunkCoordinate& coord) const { return m_Chunks.Contains(GetKey(coord)); }
+    void Clear() { m_Chunks.Clear(); }
+
+    size_t Size() const { return m_Chunks.Size(); }
+    bool Empty() const { return m_Chunks.Empty(); }
+
+    Iterator begin() const { return Iterator(m_Chunks.begin()); }
+    Iterator end() const { return Iterator(m_Chunks.end()); }
+
+private:
+    static int64_t GetKey(const ChunkCoordinate& coord) { return MakeChunkKey(coord.x, coord.y, coord.z); }
+
+    Map m_Chunks;
+};
@@ -0,0 +1,442 @@
+#include "ChunkMesher.h"
+#include <algorithm>
+#include <cstdint>
+
+// The binary mesher uses AVX2 or SSE2 when the compiler targets them, otherwise plain integer code
+#if defined(__AVX2__)
+    #define CHUNK_MESHER_AVX2 1
+    #define CHUNK_MESHER_SSE2 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CHUNK_MESHER_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+// Per-face geometry description.
+// Quads span the face's U and V axes; corner patterns are in (U, V) units and keep the
+// original counter-clockwise vertex order for each face.
+struct FaceInfo
+{
+    int Normal[3];
+    int UAxis;
+    int VAxis;
+    int Corners[4][2];
+};
+
+static const FaceInfo s_FaceInfos[6] = {
+    { { 0,  1,  0}, 0, 2, {{0, 0}, {1, 0}, {1, 1}, {0, 1}} }, // Top
+    { { 0, -1,  0}, 0, 2, {{0, 1}, {1, 1}, {1, 0}, {0, 0}} }, // Bottom
+    { { 1,  0,  0}, 2, 1, {{1, 0}, {1, 1}, {0, 1}, {0, 0}} }, // Right
+    { {-1,  0,  0}, 2, 1, {{0, 0}, {0, 1}, {1, 1}, {1, 0}} }, // Left
+    { { 0,  0,  1}, 0, 1, {{0, 0}, {0, 1}, {1, 1}, {1, 0}} }, // Front
+    { { 0,  0, -1}, 0, 1, {{1, 0}, {1, 1}, {0, 1}, {0, 0}} }, // Back
+};
+
+// Offset from a voxel to its neighbor across each face, in snapshot indices
+static int GetNeighborDelta(int face)
+{
+    const int* normal = s_FaceInfos[face].Normal;
+    return ChunkSnapshot::Index(normal[0], normal[1], normal[2]) - ChunkSnapshot::Index(0, 0, 0);
+}
+
+static bool IsTransparent(BlockType type)
+{
+    return Block{ type }.IsTransparent();
+}
+
+void ChunkMesher::BuildMesh(const ChunkSnapshot& snapshot, MeshingMode mode, std::vector<ChunkVertex>& outVertices)
+{
+    outVertices.clear();
+
+    // Uniform chunks have no internal faces; all-air chunks have nothing to draw at all,
+    // and all-solid chunks only need faces where the border exposes them
+    if (snapshot.Contents == ChunkContents::UniformAir ||
+        (snapshot.Contents == ChunkContents::UniformSolid && !HasExposedBorder(snapshot)))
+    {
+        return;
+    }
+
+    if (mode == MeshingMode::Binary)
+        BuildBinaryMesh(snapshot.Blocks.data(), outVertices);
+    else if (mode == MeshingMode::Greedy)
+        BuildGreedyMesh(snapshot.Blocks.data(), outVertices);
+    else
+        BuildNaiveMesh(snapshot.Blocks.data(), outVertices);
+}
+
+bool ChunkMesher::HasExposedBorder(const ChunkSnapshot& snapshot)
+{
+    constexpr int N = CHUNK_X_SIZE;
+    for (int face = 0; face < 6; ++face)
+    {
+        // Unloaded neighbors are assumed to bury a solid chunk
+        if (snapshot.MissingNeighborMask & (1u << face))
+            continue;
+
+        const FaceInfo& info = s_FaceInfos[face];
+        const int normalAxis = 3 - info.UAxis - info.VAxis;
+
+        // The border layer just outside this face
+        int pos[3];
+        pos[normalAxis] = info.Normal[normalAxis] > 0 ? N : -1;
+        for (int v = 0; v < N; ++v)
+        {
+            pos[info.VAxis] = v;
+            for (int u = 0; u < N; ++u)
+            {
+                pos[info.UAxis] = u;
+                if (IsTransparent(snapshot.Blocks[ChunkSnapshot::Index(pos[0], pos[1], pos[2])]))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ChunkMesher::BuildNaiveMesh(const BlockType* blocks, std::vector<ChunkVertex>& outVertices)
+{
+    int neighborDelta[6];
+    for (int face = 0; face < 6; ++face)
+        neighborDelta[face] = GetNeighborDelta(face);
+
+    // One quad per visible block face
+    for (int x = 0; x < CHUNK_X_SIZE; ++x)
+    {
+        for (int y = 0; y < CHUNK_Y_SIZE; ++y)
+        {
+            for (int z = 0; z < CHUNK_Z_SIZE; ++z)
+            {
+                const int index = ChunkSnapshot::Index(x, y, z);
+                BlockType type = blocks[index];
+                if (type == BlockType::Air)
+                    continue;
+
+                for (int face = 0; face < 6; ++face)
+                {
+                    if (IsTransparent(blocks[index + neighborDelta[face]]))
+                    {
+                        AddQuad(outVertices, static_cast<BlockFace>(face), type, x, y, z, 1, 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ChunkMesher::BuildGreedyMesh(const BlockType* blocks, std::vector<ChunkVertex>& outVertices)
+{
+    constexpr int N = CHUNK_X_SIZE;
+
+    // Visible face types for the current slice, indexed [v * N + u] (Air = no face)
+    std::array<BlockType, N * N> mask;
+
+    for (int face = 0; face < 6; ++face)
+    {
+        const FaceInfo& info = s_FaceInfos[face];
+        const int normalAxis = 3 - info.UAxis - info.VAxis;
+        const int neighborDelta = GetNeighborDelta(face);
+
+        for (int slice = 0; slice < N; ++slice)
+        {
+            // Gather the visible faces of this slice
+            int pos[3];
+            pos[normalAxis] = slice;
+            for (int v = 0; v < N; ++v)
+            {
+                pos[info.VAxis] = v;
+                for (int u = 0; u < N; ++u)
+                {
+                    pos[info.UAxis] = u;
+                    const int index = ChunkSnapshot::Index(pos[0], pos[1], pos[2]);
+                    BlockType type = blocks[index];
+                    bool visible = type != BlockType::Air && IsTransparent(blocks[index + neighborDelta]);
+                    mask[v * N + u] = visible ? type : BlockType::Air;
+                }
+            }
+
+            // Merge runs of the same block type into maximal rectangles, row by row
+            for (int v = 0; v < N; ++v)
+            {
+                for (int u = 0; u < N; )
+                {
+                    BlockType type = mask[v * N + u];
+                    if (type == BlockType::Air)
+                    {
+                        ++u;
+                        continue;
+                    }
+
+                    int width = 1;
+                    while (u + width < N && mask[v * N + u + width] == type)
+                        ++width;
+
+                    int height = 1;
+                    for (; v + height < N; ++height)
+                    {
+                        bool rowMatches = true;
+                        for (int i = 0; i < width; ++i)
+                        {
+                            if (mask[(v + height) * N + u + i] != type)
+                            {
+                                rowMatches = false;
+                                break;
+                            }
+                        }
+                        if (!rowMatches)
+                            break;
+                    }
+
+                    for (int dv = 0; dv < height; ++dv)
+                    {
+                        std::fill_n(&mask[(v + dv) * N + u], width, BlockType::Air);
+                    }
+
+                    pos[info.UAxis] = u;
+                    pos[info.VAxis] = v;
+                    AddQuad(outVertices, static_cast<BlockFace>(face), type, pos[0], pos[1], pos[2], width, height);
+                    u += width;
+                }
+            }
+        }
+    }
+}
+
+// Bitmasks for the binary mesher. A row holds one bit per voxel along a face's U axis;
+// rows are stored per normal axis as [slice + 1][v], so the padding slices -1 and N sit at
+// the ends. Solid bits are voxels that emit faces (not air), Opaque bits voxels that hide them.
+struct BinaryRowMasks
+{
+    static constexpr int N = CHUNK_X_SIZE;
+    static_assert(N == 16, "Binary meshing packs one chunk row into 16 bits");
+
+    alignas(32) uint16_t Solid[3][N + 2][N];
+    alignas(32) uint16_t Opaque[3][N + 2][N];
+};
+
+static int CountTrailingZeros(uint32_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+// Masks for the 16 voxels along X starting at row, matching Block::IsTransparent
+static void GetRowMasksX(const BlockType* row, uint16_t& outSolid, uint16_t& outOpaque)
+{
+#if CHUNK_MESHER_SSE2
+    const __m128i types = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+    const __m128i air = _mm_cmpeq_epi8(types, _mm_setzero_si128());
+    const __m128i water = _mm_cmpeq_epi8(types, _mm_set1_epi8(static_cast<char>(BlockType::Water)));
+    outSolid = static_cast<uint16_t>(~_mm_movemask_epi8(air));
+    outOpaque = static_cast<uint16_t>(~_mm_movemask_epi8(_mm_or_si128(air, water)));
+#else
+    uint32_t solid = 0;
+    uint32_t opaque = 0;
+    for (int x = 0; x < CHUNK_X_SIZE; ++x)
+    {
+        solid |= static_cast<uint32_t>(row[x] != BlockType::Air) << x;
+        opaque |= static_cast<uint32_t>(!IsTransparent(row[x])) << x;
+    }
+    outSolid = static_cast<uint16_t>(solid);
+    outOpaque = static_cast<uint16_t>(opaque);
+#endif
+}
+
+// 16x16 bit transpose: bit z of rows[z] at column x becomes bit z of outColumns[x]
+static void TransposeRows(const uint16_t* rows, uint16_t* outColumns)
+{
+#if CHUNK_MESHER_SSE2
+    // Split the rows into their low and high bytes, then peel one bit column per movemask
+    const __m128i rows0 = _mm_load_si128(reinterpret_cast<const __m128i*>(rows));
+    const __m128i rows1 = _mm_load_si128(reinterpret_cast<const __m128i*>(rows + 8));
+    const __m128i lowMask = _mm_set1_epi16(0x00FF);
+    __m128i low = _mm_packus_epi16(_mm_and_si128(rows0, lowMask), _mm_and_si128(rows1, lowMask));
+    __m128i high = _mm_packus_epi16(_mm_srli_epi16(rows0, 8), _mm_srli_epi16(rows1, 8));
+    for (int bit = 7; bit >= 0; --bit)
+    {
+        outColumns[bit] = static_cast<uint16_t>(_mm_movemask_epi8(low));
+        outColumns[bit + 8] = static_cast<uint16_t>(_mm_movemask_epi8(high));
+        low = _mm_add_epi8(low, low);
+        high = _mm_add_epi8(high, high);
+    }
+#else
+    std::fill_n(outColumns, CHUNK_X_SIZE, static_cast<uint16_t>(0));
+    for (int z = 0; z < CHUNK_Z_SIZE; ++z)
+    {
+        for (uint32_t bits = rows[z]; bits != 0; bits &= bits - 1)
+            outColumns[CountTrailingZeros(bits)] |= static_cast<uint16_t>(1u << z);
+    }
+#endif
+}
+
+static void BuildBinaryRowMasks(const BlockType* blocks, BinaryRowMasks& masks)
+{
+    constexpr int N = BinaryRowMasks::N;
+    constexpr int AxisX = 0, AxisY = 1, AxisZ = 2;
+
+    // Rows along X serve the Y faces ([y][z]) and the Z faces ([z][y]); the padding
+    // edges and corners are never read by a face test, so they are skipped
+    for (int y = -1; y <= N; ++y)
+    {
+        for (int z = -1; z <= N; ++z)
+        {
+            const bool paddedY = y < 0 || y == N;
+            const bool paddedZ = z < 0 || z == N;
+            if (paddedY && paddedZ)
+                continue;
+
+            uint16_t solid, opaque;
+            GetRowMasksX(blocks + ChunkSnapshot::Index(0, y, z), solid, opaque);
+            if (!paddedZ)
+            {
+                masks.Solid[AxisY][y + 1][z] = solid;
+                masks.Opaque[AxisY][y + 1][z] = opaque;
+            }
+            if (!paddedY)
+            {
+                masks.Solid[AxisZ][z + 1][y] = solid;
+                masks.Opaque[AxisZ][z + 1][y] = opaque;
+            }
+        }
+    }
+
+    // Rows along Z for the X faces ([x][y]) are the transposed interior rows along X
+    alignas(16) uint16_t columns[N];
+    for (int y = 0; y < N; ++y)
+    {
+        TransposeRows(masks.Solid[AxisY][y + 1], columns);
+        for (int x = 0; x < N; ++x)
+            masks.Solid[AxisX][x + 1][y] = columns[x];
+
+        TransposeRows(masks.Opaque[AxisY][y + 1], columns);
+        for (int x = 0; x < N; ++x)
+            masks.Opaque[AxisX][x + 1][y] = columns[x];
+    }
+
+    // The X padding slices are only ever neighbors
+    for (int slice : { -1, N })
+    {
+        for (int y = 0; y < N; ++y)
+        {
+            uint32_t opaque = 0;
+            for (int z = 0; z < N; ++z)
+                opaque |= static_cast<uint32_t>(!IsTransparent(blocks[ChunkSnapshot::Index(slice, y, z)])) << z;
+            masks.Opaque[AxisX][slice + 1][y] = static_cast<uint16_t>(opaque);
+        }
+    }
+}
+
+// Faces of a slice not hidden by the slice in front of them: solid AND NOT opaque, all 16 rows at once
+static void CullSliceFaces(const uint16_t* solid, const uint16_t* opaqueNeighbor, uint16_t* outVisible)
+{
+#if CHUNK_MESHER_AVX2
+    const __m256i rows = _mm256_load_si256(reinterpret_cast<const __m256i*>(solid));
+    const __m256i hidden = _mm256_load_si256(reinterpret_cast<const __m256i*>(opaqueNeighbor));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(outVisible), _mm256_andnot_si256(hidden, rows));
+#elif CHUNK_MESHER_SSE2
+    for (int v = 0; v < CHUNK_X_SIZE; v += 8)
+    {
+        const __m128i rows = _mm_load_si128(reinterpret_cast<const __m128i*>(solid + v));
+        const __m128i hidden = _mm_load_si128(reinterpret_cast<const __m128i*>(opaqueNeighbor + v));
+        _mm_store_si128(reinterpret_cast<__m128i*>(outVisible + v), _mm_andnot_si128(hidden, rows));
+    }
+#else
+    for (int v = 0; v < CHUNK_X_SIZE; ++v)
+        outVisible[v] = static_cast<uint16_t>(solid[v] & ~opaqueNeighbor[v]);
+#endif
+}
+
+void ChunkMesher::BuildBinaryMesh(const BlockType* blocks, std::vector<ChunkVertex>& outVertices)
+{
+    constexpr int N = BinaryRowMasks::N;
+
+    BinaryRowMasks masks;
+    BuildBinaryRowMasks(blocks, masks);
+
+    // Visible faces of the current slice, and the same faces split by block type
+    alignas(32) uint16_t visible[N];
+    uint16_t typeRows[static_cast<int>(BlockType::Count)][N] = {};
+
+    for (int face = 0; face < 6; ++face)
+    {
+        const FaceInfo& info = s_FaceInfos[face];
+        const int normalAxis = 3 - info.UAxis - info.VAxis;
+        const int normalStep = info.Normal[normalAxis];
+
+        for (int slice = 0; slice < N; ++slice)
+        {
+            CullSliceFaces(masks.Solid[normalAxis][slice + 1], masks.Opaque[normalAxis][slice + 1 + normalStep], visible);
+
+            int pos[3];
+            pos[normalAxis] = slice;
+            for (int v = 0; v < N; ++v)
+            {
+                pos[info.VAxis] = v;
+                for (uint32_t bits = visible[v]; bits != 0; bits &= bits - 1)
+                {
+                    pos[info.UAxis] = CountTrailingZeros(bits);
+                    BlockType type = blocks[ChunkSnapshot::Index(pos[0], pos[1], pos[2])];
+                    typeRows[static_cast<int>(type)][v] |= static_cast<uint16_t>(1u << pos[info.UAxis]);
+                }
+            }
+
+            // Same merge order as BuildGreedyMesh: the first unmerged face of each row starts a
+            // rectangle, which grows along U over its type's run, then along V while rows match.
+            // Every visible bit is consumed, so the type rows are all clear again afterwards.
+            for (int v = 0; v < N; ++v)
+            {
+                while (visible[v] != 0)
+                {
+                    const int u = CountTrailingZeros(visible[v]);
+                    pos[info.UAxis] = u;
+                    pos[info.VAxis] = v;
+                    BlockType type = blocks[ChunkSnapshot::Index(pos[0], pos[1], pos[2])];
+                    uint16_t* rows = typeRows[static_cast<int>(type)];
+
+                    const int width = CountTrailingZeros(~(static_cast<uint32_t>(rows[v]) >> u));
+                    const uint32_t runMask = ((1u << width) - 1) << u;
+
+                    int height = 1;
+                    while (v + height < N && (rows[v + height] & runMask) == runMask)
+                        ++height;
+
+                    for (int dv = 0; dv < height; ++dv)
+                    {
+                        rows[v + dv] &= static_cast<uint16_t>(~runMask);
+                        visible[v + dv] &= static_cast<uint16_t>(~runMask);
+                    }
+
+                    AddQuad(outVertices, static_cast<BlockFace>(face), type, pos[0], pos[1], pos[2], width, height);
+                }
+            }
+        }
+    }
+}
+
+void ChunkMesher::AddQuad(std::vector<ChunkVertex>& outVertices, BlockFace face, BlockType type, int x, int y, int z, int width, int height)
+{
+    const FaceInfo& info = s_FaceInfos[static_cast<int>(face)];
+
+    // Quad origin in chunk space: positive faces sit on the far side of the block
+    const int base[3] = {
+        x + std::max(info.Normal[0], 0),
+        y + std::max(info.Normal[1], 0),
+        z + std::max(info.Normal[2], 0)
+    };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int position[3] = { base[0], base[1], base[2] };
+        position[info.UAxis] += info.Corners[i][0] * width;
+        position[info.VAxis] += info.Corners[i][1] * height;
+        outVertices.push_back(ChunkVertex::Pack(position[0], position[1], position[2], face, type));
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Chunk.h"
+#include <array>
+#include <vector>
+
+// Mesher input: the chunk's blocks plus a one-voxel border copied from its six face
+// neighbors, gathered once on the main thread. Indexed like ChunkBlockIndex with every
+// coordinate shifted by one, so -1..16 are all valid and face tests never leave the array.
+// The edges and corners of the border are unused by the face tests.
+struct ChunkSnapshot
+{
+    static constexpr int Size = CHUNK_X_SIZE + 2;
+    static constexpr int Volume = Size * Size * Size;
+
+    static constexpr int Index(int x, int y, int z)
+    {
+        return (x + 1) + Size * ((z + 1) + Size * (y + 1));
+    }
+
+    std::array<BlockType, Volume> Blocks;
+    ChunkContents Contents = ChunkContents::Mixed;
+    uint8_t MissingNeighborMask = 0;    // Sides (bit per BlockFace) whose neighbor was not loaded
+};
+static_assert(CHUNK_X_SIZE == CHUNK_Y_SIZE && CHUNK_Y_SIZE == CHUNK_Z_SIZE, "ChunkSnapshot assumes cubic chunks");
+
+// Turns a snapshot into packed quads. Pure function of its input, so it runs on worker threads.
+class ChunkMesher
+{
+public:
+    static void BuildMesh(const ChunkSnapshot& snapshot, MeshingMode mode, std::vector<ChunkVertex>& outVertices);
+
+private:
+    static bool HasExposedBorder(const ChunkSnapshot& snapshot);
+    static void BuildNaiveMesh(const BlockType* blocks, std::vector<ChunkVertex>& outVertices);
+    static void BuildGreedyMesh(const BlockType* blocks, std::vector<ChunkVertex>& outVertices);
+    static void BuildBinaryMesh(const BlockType* blocks, std::vector<ChunkVertex>& outVertices);
+    static void AddQuad(std::vector<ChunkVertex>& outVertices, BlockFace face, BlockType type, int x, int y, int z, int width, int height);
+};
@@ -0,0 +1,80 @@
+#include "ChunkPool.h"
+
+// Without a mesh buffer pool, recycled chunks keeping a buffer larger than this (in vertices) free it
+static constexpr size_t s_MaxRetainedVertices = 16 * 1024;
+
+void ChunkRecycler::operator()(Chunk* chunk) const
+{
+    if (Pool != nullptr)
+        Pool->Release(chunk);
+    else
+        delete chunk;
+}
+
+ChunkPool::ChunkPool(MeshBufferPool* meshBuffers, size_t maxPooled)
+    : m_MeshBuffers(meshBuffers), m_MaxPooled(maxPooled)
+{
+    m_Free.reserve(maxPooled);
+}
+
+ChunkPool::~ChunkPool()
+{
+    for (Chunk* chunk : m_Free)
+    {
+        delete chunk;
+    }
+}
+
+ChunkPtr ChunkPool::Acquire(int chunkX, int chunkY, int chunkZ)
+{
+    Chunk* chunk = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Free.empty())
+        {
+            chunk = m_Free.back();
+            m_Free.pop_back();
+            m_ChunksReused++;
+        }
+        else
+        {
+            m_ChunksAllocated++;
+        }
+    }
+
+    if (chunk != nullptr)
+        chunk->Reset(chunkX, chunkY, chunkZ);
+    else
+        chunk = new Chunk(chunkX, chunkY, chunkZ);
+    return ChunkPtr(chunk, ChunkRecycler{this});
+}
+
+void ChunkPool::Release(Chunk* chunk)
+{
+    // Voxels go back to the slab now rather than when the chunk is reused
+    chunk->Reset(0, 0, 0);
+    if (m_MeshBuffers != nullptr)
+        chunk->ReleaseMeshBuffer(*m_MeshBuffers);
+    else if (chunk->GetVertices().capacity() > s_MaxRetainedVertices)
+        chunk->ReleaseMeshBuffer();
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Free.size() < m_MaxPooled)
+        {
+            m_Free.push_back(chunk);
+            return;
+        }
+    }
+    delete chunk;
+}
+
+ChunkPoolStats ChunkPool::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ChunkPoolStats stats;
+    stats.ChunksAllocated = m_ChunksAllocated;
+    stats.ChunksReused = m_ChunksReused;
+    stats.ChunksPooled = m_Free.size();
+    return stats;
+}
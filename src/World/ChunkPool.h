@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Chunk.h"
+#include "MeshBufferPool.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ChunkPool;
+
+// Returns a chunk to the pool it came from (or deletes it if it has none)
+struct ChunkRecycler
+{
+    ChunkPool* Pool = nullptr;
+    void operator()(Chunk* chunk) const;
+};
+
+using ChunkPtr = std::unique_ptr<Chunk, ChunkRecycler>;
+
+struct ChunkPoolStats
+{
+    size_t ChunksAllocated = 0;     // Heap allocations of Chunk objects
+    size_t ChunksReused = 0;
+    size_t ChunksPooled = 0;        // Waiting in the pool right now
+};
+
+// Recycles Chunk objects so streaming doesn't allocate a chunk per load and free it per unload.
+// A released chunk gives its voxels back to the BlockSlab and its mesh buffer to the
+// MeshBufferPool, if the pool has one, so a pooled chunk doesn't sit on a buffer another chunk
+// could mesh into. Shared by the workers, which acquire chunks to generate into, and the main
+// thread, which releases them.
+class ChunkPool
+{
+public:
+    static constexpr size_t DefaultMaxPooled = 1024;
+
+    explicit ChunkPool(MeshBufferPool* meshBuffers = nullptr, size_t maxPooled = DefaultMaxPooled);
+    ~ChunkPool();
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    ChunkPtr Acquire(int chunkX, int chunkY, int chunkZ);
+    void Release(Chunk* chunk);
+
+    ChunkPoolStats GetStats() const;
+
+private:
+    MeshBufferPool* m_MeshBuffers;     // Main thread only, like Release
+    size_t m_MaxPooled;
+    std::vector<Chunk*> m_Free;
+    mutable std::mutex m_Mutex;
+    size_t m_ChunksAllocated = 0;
+    size_t m_ChunksReused = 0;
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "ChunkCoordinate.h"
+#include "ChunkMap.h"
+#include <algorithm>
+#include <vector>
+
+// Persistent priority queue of chunk requests (lowest priority value first).
+// It is updated incrementally as chunks enter or leave the streaming volume instead of
+// being rebuilt. Removal is lazy (heap entries whose chunk is no longer queued are skipped),
+// and priorities are re-evaluated on pop, so entries whose priority got worse since they
+// were pushed are re-inserted rather than served out of order.
+class ChunkPriorityQueue
+{
+public:
+    void Push(const ChunkCoordinate& coord, float priority)
+    {
+        if (!m_Queued.Insert(coord))
+            return;
+
+        m_Heap.push_back(Entry{priority, coord});
+        std::push_heap(m_Heap.begin(), m_Heap.end());
+    }
+
+    void Remove(const ChunkCoordinate& coord)
+    {
+        if (m_Queued.Erase(coord))
+            CompactIfStale();
+    }
+
+    // Pops the most urgent chunk; currentPriority(coord) re-evaluates an entry's priority
+    template <typename PriorityFunc>
+    bool Pop(ChunkCoordinate& outCoord, PriorityFunc currentPriority)
+    {
+        while (!m_Heap.empty())
+        {
+            std::pop_heap(m_Heap.begin(), m_Heap.end());
+            Entry entry = m_Heap.back();
+            m_Heap.pop_back();
+
+            if (!m_Queued.Contains(entry.Coord))
+                continue; // Removed after it was pushed
+
+            // Priority got worse since it was pushed: requeue it behind the new front
+            float priority = currentPriority(entry.Coord);
+            if (!m_Heap.empty() && priority > m_Heap.front().Priority)
+            {
+                m_Heap.push_back(Entry{priority, entry.Coord});
+                std::push_heap(m_Heap.begin(), m_Heap.end());
+                continue;
+            }
+
+            m_Queued.Erase(entry.Coord);
+            outCoord = entry.Coord;
+            return true;
+        }
+        return false;
+    }
+
+    // Re-evaluates every queued chunk and rebuilds the heap, for when priorities may have improved
+    // (lazy re-evaluation on pop only catches priorities that got worse)
+    template <typename PriorityFunc>
+    void Reprioritize(PriorityFunc currentPriority)
+    {
+        m_Heap.clear();
+        for (const ChunkCoordinate& coord : m_Queued)
+            m_Heap.push_back(Entry{currentPriority(coord), coord});
+        std::make_heap(m_Heap.begin(), m_Heap.end());
+    }
+
+    bool Contains(const ChunkCoordinate& coord) const { return m_Queued.Contains(coord); }
+    size_t Size() const { return m_Queued.Size(); }
+    bool Empty() const { return m_Queued.Empty(); }
+
+    void Clear()
+    {
+        m_Heap.clear();
+        m_Queued.Clear();
+    }
+
+private:
+    struct Entry
+    {
+        float Priority;
+        ChunkCoordinate Coord;
+
+        bool operator<(const Entry& other) const { return Priority > other.Priority; } // Min-heap
+    };
+
+    // Drop removed entries once they dominate the heap, so it can't grow without bound
+    void CompactIfStale()
+    {
+        if (m_Heap.size() < 1024 || m_Heap.size() < m_Queued.Size() * 4)
+            return;
+
+        m_Heap.erase(std::remove_if(m_Heap.begin(), m_Heap.end(),
+                                    [this](const Entry& entry) { return !m_Queued.Contains(entry.Coord); }),
+                     m_Heap.end());
+        std::make_heap(m_Heap.begin(), m_Heap.end());
+    }
+
+    std::vector<Entry> m_Heap;
+    ChunkSet m_Queued;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ChunkCoordinate.h"
+#include <cstddef>
+#include <vector>
+
+// FIFO of chunk coordinates on a power-of-two ring buffer. Unlike std::deque it keeps its storage
+// when drained, so a queue that fills and empties every frame stops allocating once it has seen
+// its peak length.
+class ChunkQueue
+{
+public:
+    void Push(const ChunkCoordinate& coord)
+    {
+        if (m_Size == m_Ring.size())
+            Grow();
+        m_Ring[(m_Head + m_Size) & (m_Ring.size() - 1)] = coord;
+        m_Size++;
+    }
+
+    ChunkCoordinate Pop()
+    {
+        ChunkCoordinate coord = m_Ring[m_Head];
+        m_Head = (m_Head + 1) & (m_Ring.size() - 1);
+        m_Size--;
+        return coord;
+    }
+
+    void Clear()
+    {
+        m_Head = 0;
+        m_Size = 0;
+    }
+
+    size_t Size() const { return m_Size; }
+    bool Empty() const { return m_Size == 0; }
+
+private:
+    static constexpr size_t MinCapacity = 64;
+
+    void Grow()
+    {
+        std::vector<ChunkCoordinate> ring;
+        ring.reserve(m_Ring.empty() ? MinCapacity : m_Ring.size() * 2);
+        for (size_t i = 0; i < m_Size; ++i)
+            ring.push_back(m_Ring[(m_Head + i) & (m_Ring.size() - 1)]);
+        ring.resize(ring.capacity(), ChunkCoordinate(0, 0, 0));
+        m_Ring.swap(ring);
+        m_Head = 0;
+    }
+
+    std::vector<ChunkCoordinate> m_Ring;
+    size_t m_Head = 0;
+    size_t m_Size = 0;
+};
@@ -0,0 +1,168 @@
+#include "ChunkWorkerPool.h"
+#include "../Core/AllocationCounter.h"
+#include "../Core/Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+ChunkWorkerPool::ChunkWorkerPool(TerrainColumnCache& columns, ChunkPool& chunks, size_t threadCount)
+    : m_Columns(columns), m_Chunks(chunks)
+{
+    if (threadCount == 0)
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_Workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        m_Workers.emplace_back(&ChunkWorkerPool::WorkerLoop, this);
+    }
+}
+
+ChunkWorkerPool::~ChunkWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_JobsMutex);
+        m_Stopping = true;
+    }
+    m_JobsAvailable.notify_all();
+
+    for (std::thread& worker : m_Workers)
+    {
+        worker.join();
+    }
+}
+
+void ChunkWorkerPool::Submit(int chunkX, int chunkY, int chunkZ, float priority)
+{
+    m_InFlight++;
+    {
+        std::lock_guard<std::mutex> lock(m_JobsMutex);
+        m_Jobs.push_back(Job{chunkX, chunkY, chunkZ, priority, nullptr});
+        std::push_heap(m_Jobs.begin(), m_Jobs.end());
+    }
+    m_JobsAvailable.notify_one();
+}
+
+void ChunkWorkerPool::CollectCompleted(std::vector<ChunkJobResult>& outResults)
+{
+    std::lock_guard<std::mutex> lock(m_CompletedMutex);
+    m_InFlight -= m_Completed.size();
+    for (ChunkJobResult& result : m_Completed)
+    {
+        outResults.push_back(std::move(result));
+    }
+    m_Completed.clear();
+}
+
+ChunkMeshJobPtr ChunkWorkerPool::AcquireMeshJob()
+{
+    if (m_FreeMeshJobs.empty())
+        return std::make_unique<ChunkMeshJob>();
+
+    ChunkMeshJobPtr job = std::move(m_FreeMeshJobs.back());
+    m_FreeMeshJobs.pop_back();
+    return job;
+}
+
+void ChunkWorkerPool::SubmitMesh(ChunkMeshJobPtr job, float priority)
+{
+    m_InFlight++;
+    {
+        std::lock_guard<std::mutex> lock(m_JobsMutex);
+        const ChunkCoordinate coord = job->Coord;
+        m_Jobs.push_back(Job{coord.x, coord.y, coord.z, priority, std::move(job)});
+        std::push_heap(m_Jobs.begin(), m_Jobs.end());
+    }
+    m_JobsAvailable.notify_one();
+}
+
+void ChunkWorkerPool::CollectCompletedMeshes(std::vector<ChunkMeshJobPtr>& outJobs)
+{
+    std::lock_guard<std::mutex> lock(m_CompletedMutex);
+    m_InFlight -= m_CompletedMeshes.size();
+    for (ChunkMeshJobPtr& job : m_CompletedMeshes)
+    {
+        outJobs.push_back(std::move(job));
+    }
+    m_CompletedMeshes.clear();
+}
+
+void ChunkWorkerPool::ReleaseMeshJob(ChunkMeshJobPtr job)
+{
+    m_FreeMeshJobs.push_back(std::move(job));
+}
+
+void ChunkWorkerPool::Cancel(const std::vector<ChunkCoordinate>& coords, std::vector<ChunkCoordinate>& outCancelled)
+{
+    std::lock_guard<std::mutex> lock(m_JobsMutex);
+    auto isCancelled = [&coords](const Job& job)
+    {
+        return !job.Mesh && std::find(coords.begin(), coords.end(), ChunkCoordinate(job.ChunkX, job.ChunkY, job.ChunkZ)) != coords.end();
+    };
+
+    auto firstCancelled = std::partition(m_Jobs.begin(), m_Jobs.end(), [&isCancelled](const Job& job) { return !isCancelled(job); });
+    for (auto it = firstCancelled; it != m_Jobs.end(); ++it)
+    {
+        outCancelled.emplace_back(it->ChunkX, it->ChunkY, it->ChunkZ);
+    }
+    m_InFlight -= m_Jobs.end() - firstCancelled;
+    m_Jobs.erase(firstCancelled, m_Jobs.end());
+    std::make_heap(m_Jobs.begin(), m_Jobs.end());
+}
+
+size_t ChunkWorkerPool::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_JobsMutex);
+    return m_Jobs.size();
+}
+
+void ChunkWorkerPool::WorkerLoop()
+{
+    PROFILE_THREAD("Chunk worker");
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_JobsMutex);
+            m_JobsAvailable.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+            if (m_Stopping)
+                return;
+
+            std::pop_heap(m_Jobs.begin(), m_Jobs.end());
+            job = std::move(m_Jobs.back());
+            m_Jobs.pop_back();
+        }
+        const uint64_t allocationsBefore = AllocationCounter::GetThreadAllocations();
+
+        // Meshing reads only the snapshot the main thread gathered, never the live chunk map
+        if (job.Mesh)
+        {
+            PROFILE_SCOPE("ChunkWorkerPool::MeshJob");
+            auto startTime = std::chrono::high_resolution_clock::now();
+            ChunkMesher::BuildMesh(job.Mesh->Snapshot, job.Mesh->Mode, job.Mesh->Vertices);
+            auto endTime = std::chrono::high_resolution_clock::now();
+            job.Mesh->BuildTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            m_CompletedMeshes.push_back(std::move(job.Mesh));
+            m_JobAllocations.fetch_add(AllocationCounter::GetThreadAllocations() - allocationsBefore, std::memory_order_relaxed);
+            continue;
+        }
+
+        PROFILE_SCOPE("ChunkWorkerPool::Job");
+        auto startTime = std::chrono::high_resolution_clock::now();
+        ChunkJobResult result;
+        result.ChunkData = m_Chunks.Acquire(job.ChunkX, job.ChunkY, job.ChunkZ);
+        std::shared_ptr<const TerrainColumn> column = m_Columns.GetColumn(job.ChunkX, job.ChunkZ);
+        result.ChunkData->Generate(*column);
+        result.Band = WorldGenerator::GetSurfaceBand(*column);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        result.GenerationTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+        m_Completed.push_back(std::move(result));
+        m_JobAllocations.fetch_add(AllocationCounter::GetThreadAllocations() - allocationsBefore, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ChunkPool.h"
+#include "ChunkCoordinate.h"
+#include "ChunkMesher.h"
+#include "TerrainColumnCache.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A generated chunk handed back from a worker thread
+struct ChunkJobResult
+{
+    ChunkPtr ChunkData;
+    SurfaceBand Band;                   // Of the chunk's column
+    double GenerationTimeMs = 0.0;
+};
+
+// A mesh build: the main thread fills in the snapshot, a worker meshes it into Vertices.
+// MeshVersion is the version the chunk's mesh takes when the result is applied; a result whose
+// chunk has been snapshotted again since is stale and dropped. Recycled through the pool, so the
+// snapshot and the vertex buffer are only allocated while the pool warms up.
+struct ChunkMeshJob
+{
+    ChunkCoordinate Coord{0, 0, 0};
+    uint32_t MeshVersion = 0;
+    MeshingMode Mode = MeshingMode::Greedy;
+    ChunkSnapshot Snapshot;
+    std::vector<ChunkVertex> Vertices;
+    double BuildTimeMs = 0.0;
+};
+
+using ChunkMeshJobPtr = std::unique_ptr<ChunkMeshJob>;
+
+// Thread pool that generates and meshes chunks off the render thread.
+// Jobs are picked in priority order (lowest value first); results are collected by the main
+// thread, which owns insertion into the world, the neighbor snapshots meshing reads and GPU upload.
+// Generation jobs no worker has picked up yet can be cancelled; a job already running still completes.
+class ChunkWorkerPool
+{
+public:
+    // threadCount == 0 sizes the pool to the hardware (one core left for the main thread)
+    ChunkWorkerPool(TerrainColumnCache& columns, ChunkPool& chunks, size_t threadCount = 0);
+    ~ChunkWorkerPool();
+
+    ChunkWorkerPool(const ChunkWorkerPool&) = delete;
+    ChunkWorkerPool& operator=(const ChunkWorkerPool&) = delete;
+
+    void Submit(int chunkX, int chunkY, int chunkZ, float priority);
+    void CollectCompleted(std::vector<ChunkJobResult>& outResults);
+    void Cancel(const std::vector<ChunkCoordinate>& coords, std::vector<ChunkCoordinate>& outCancelled);
+
+    // Mesh jobs; acquire and release happen on the main thread only
+    ChunkMeshJobPtr AcquireMeshJob();
+    void SubmitMesh(ChunkMeshJobPtr job, float priority);
+    void CollectCompletedMeshes(std::vector<ChunkMeshJobPtr>& outJobs);
+    void ReleaseMeshJob(ChunkMeshJobPtr job);
+
+    size_t GetWorkerCount() const { return m_Workers.size(); }
+    size_t GetPendingCount() const;
+    size_t GetInFlightCount() const { return m_InFlight.load(); }
+
+    // Heap allocations the workers made running jobs since the last call
+    uint64_t TakeJobAllocations() { return m_JobAllocations.exchange(0, std::memory_order_relaxed); }
+
+private:
+    struct Job
+    {
+        int ChunkX, ChunkY, ChunkZ;
+        float Priority;
+        ChunkMeshJobPtr Mesh;           // Null for a generation job
+
+        bool operator<(const Job& other) const { return Priority > other.Priority; } // Min-heap on priority
+    };
+
+    void WorkerLoop();
+
+    TerrainColumnCache& m_Columns;     // Shared 2D terrain data for the chunk stacks
+    ChunkPool& m_Chunks;               // Recycled chunks to generate into
+    std::vector<std::thread> m_Workers;
+    std::vector<Job> m_Jobs;           // Binary heap, see Job::operator<
+    std::vector<ChunkJobResult> m_Completed;
+    std::vector<ChunkMeshJobPtr> m_CompletedMeshes;
+    std::vector<ChunkMeshJobPtr> m_FreeMeshJobs;    // Main thread only
+    mutable std::mutex m_JobsMutex;
+    std::mutex m_CompletedMutex;
+    std::condition_variable m_JobsAvailable;
+    std::atomic<size_t> m_InFlight{0};   // Submitted but not yet collected
+    std::atomic<uint64_t> m_JobAllocations{0};
+    bool m_Stopping = false;
+};
@@ -0,0 +1,77 @@
+#include "MeshBufferPool.h"
+
+MeshBufferPool::MeshBufferPool(size_t memoryBudget)
+    : m_MemoryBudget(memoryBudget)
+{
+}
+
+void MeshBufferPool::Exchange(std::vector<ChunkVertex>& buffer, size_t vertexCount)
+{
+    // An empty mesh needs no buffer; a mesh too large for any class gets an exact one
+    const size_t sizeClass = GetClass(vertexCount);
+    const size_t capacity = vertexCount == 0 ? 0 : sizeClass < ClassCount ? GetClassVertices(sizeClass) : vertexCount;
+    buffer.clear();
+    if (buffer.capacity() == capacity)
+        return;
+
+    Release(buffer);
+    if (capacity == 0)
+        return;
+
+    if (sizeClass < ClassCount && !m_Free[sizeClass].empty())
+    {
+        buffer.swap(m_Free[sizeClass].back());
+        m_Free[sizeClass].pop_back();
+        m_PooledBytes -= capacity * sizeof(ChunkVertex);
+        m_BuffersReused++;
+        return;
+    }
+
+    buffer.reserve(capacity);
+    m_BuffersAllocated++;
+}
+
+MeshBufferPoolStats MeshBufferPool::GetStats() const
+{
+    MeshBufferPoolStats stats;
+    stats.BuffersAllocated = m_BuffersAllocated;
+    stats.BuffersReused = m_BuffersReused;
+    for (const std::vector<std::vector<ChunkVertex>>& buffers : m_Free)
+    {
+        stats.BuffersPooled += buffers.size();
+    }
+    stats.PooledBytes = m_PooledBytes;
+    return stats;
+}
+
+size_t MeshBufferPool::GetClass(size_t vertexCount)
+{
+    if (vertexCount == 0)
+        return ClassCount;
+
+    size_t sizeClass = 0;
+    while (sizeClass < ClassCount && GetClassVertices(sizeClass) < vertexCount)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+// Pools the buffer if it is exactly a class size and fits the budget, frees it otherwise
+void MeshBufferPool::Release(std::vector<ChunkVertex>& buffer)
+{
+    const size_t capacity = buffer.capacity();
+    if (capacity == 0)
+        return;
+
+    const size_t sizeClass = GetClass(capacity);
+    const size_t bytes = capacity * sizeof(ChunkVertex);
+    if (sizeClass < ClassCount && GetClassVertices(sizeClass) == capacity && m_PooledBytes + bytes <= m_MemoryBudget)
+    {
+        m_Free[sizeClass].emplace_back();
+        m_Free[sizeClass].back().swap(buffer);
+        m_PooledBytes += bytes;
+        return;
+    }
+    std::vector<ChunkVertex>().swap(buffer);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Chunk.h"
+#include <cstddef>
+#include <vector>
+
+struct MeshBufferPoolStats
+{
+    size_t BuffersAllocated = 0;    // Heap allocations of vertex buffers
+    size_t BuffersReused = 0;
+    size_t BuffersPooled = 0;       // Waiting in the pool right now
+    size_t PooledBytes = 0;
+};
+
+// Recycles the CPU vertex buffers chunks keep their mesh in. Buffers come in power-of-two size
+// classes, and a chunk trades its buffer for one of the class its new mesh needs, so buffers
+// circulate between chunks instead of every recycled chunk growing its own to fit whatever it
+// meshes next. Once every class has seen its peak demand, applying meshes stops allocating.
+// Main thread only.
+class MeshBufferPool
+{
+public:
+    static constexpr size_t DefaultMemoryBudget = 16 * 1024 * 1024;
+
+    explicit MeshBufferPool(size_t memoryBudget = DefaultMemoryBudget);
+
+    MeshBufferPool(const MeshBufferPool&) = delete;
+    MeshBufferPool& operator=(const MeshBufferPool&) = delete;
+
+    // Swaps the buffer for an empty one of the class that fits vertexCount, unless it already is one
+    void Exchange(std::vector<ChunkVertex>& buffer, size_t vertexCount);
+
+    MeshBufferPoolStats GetStats() const;
+
+private:
+    static constexpr size_t MinClassVertices = 256;
+    static constexpr size_t ClassCount = 10;    // Up to 128K vertices, above the worst-case chunk mesh
+
+    // Class index for a vertex count, or ClassCount if it needs no buffer or is too large to pool
+    static size_t GetClass(size_t vertexCount);
+    static size_t GetClassVertices(size_t sizeClass) { return MinClassVertices << sizeClass; }
+
+    void Release(std::vector<ChunkVertex>& buffer);
+
+    size_t m_MemoryBudget;
+    size_t m_PooledBytes = 0;
+    std::vector<std::vector<ChunkVertex>> m_Free[ClassCount];
+    size_t m_BuffersAllocated = 0;
+    size_t m_BuffersReused = 0;
+};
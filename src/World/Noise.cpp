@@ -0,0 +1,314 @@
+#include "Noise.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// Same compile-time selection as the binary mesher
+#if defined(__AVX2__)
+    #define NOISE_AVX2 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define NOISE_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+// Lattice hash constants
+static constexpr uint32_t s_PrimeX = 0x27D4EB2Du;
+static constexpr uint32_t s_PrimeY = 0x165667B1u;
+static constexpr uint32_t s_HashMix = 0x2C1B3C6Du;
+
+// Per-octave seed step, so octaves don't share a lattice
+static constexpr uint32_t s_OctaveSeedStep = 0x9E3779B9u;
+
+static uint32_t HashLattice(int32_t ix, int32_t iy, uint32_t seed)
+{
+    uint32_t h = seed ^ (static_cast<uint32_t>(ix) * s_PrimeX) ^ (static_cast<uint32_t>(iy) * s_PrimeY);
+    h = (h ^ (h >> 15)) * s_HashMix;
+    h ^= h >> 13;
+    return h;
+}
+
+// Diagonal gradients (+-1, +-1) picked by the two low hash bits; the sign flips are exact,
+// so the vector kernels reproduce them with a sign-bit XOR
+static float GradientDot(uint32_t h, float fx, float fy)
+{
+    float gx = (h & 1) ? -fx : fx;
+    float gy = (h & 2) ? -fy : fy;
+    return gx + gy;
+}
+
+static float Fade(float t)
+{
+    float inner = t * 6.0f - 15.0f;
+    inner = t * inner + 10.0f;
+    return ((t * t) * t) * inner;
+}
+
+static float Lerp(float a, float b, float t)
+{
+    return a + t * (b - a);
+}
+
+float Noise::Gradient2D(float x, float y, uint32_t seed)
+{
+    const float x0 = std::floor(x);
+    const float y0 = std::floor(y);
+    const int32_t ix = static_cast<int32_t>(x0);
+    const int32_t iy = static_cast<int32_t>(y0);
+    const float fx = x - x0;
+    const float fy = y - y0;
+
+    const float n00 = GradientDot(HashLattice(ix, iy, seed), fx, fy);
+    const float n10 = GradientDot(HashLattice(ix + 1, iy, seed), fx - 1.0f, fy);
+    const float n01 = GradientDot(HashLattice(ix, iy + 1, seed), fx, fy - 1.0f);
+    const float n11 = GradientDot(HashLattice(ix + 1, iy + 1, seed), fx - 1.0f, fy - 1.0f);
+
+    const float u = Fade(fx);
+    const float v = Fade(fy);
+    return Lerp(Lerp(n00, n10, u), Lerp(n01, n11, u), v);
+}
+
+#if NOISE_AVX2
+
+static __m256i HashLattice8(__m256i ix, __m256i iy, __m256i seed)
+{
+    __m256i h = _mm256_xor_si256(seed, _mm256_mullo_epi32(ix, _mm256_set1_epi32(static_cast<int>(s_PrimeX))));
+    h = _mm256_xor_si256(h, _mm256_mullo_epi32(iy, _mm256_set1_epi32(static_cast<int>(s_PrimeY))));
+    h = _mm256_mullo_epi32(_mm256_xor_si256(h, _mm256_srli_epi32(h, 15)), _mm256_set1_epi32(static_cast<int>(s_HashMix)));
+    return _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+}
+
+static __m256 GradientDot8(__m256i h, __m256 fx, __m256 fy)
+{
+    const __m256 gx = _mm256_xor_ps(fx, _mm256_castsi256_ps(_mm256_slli_epi32(h, 31)));
+    const __m256 gy = _mm256_xor_ps(fy, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30)));
+    return _mm256_add_ps(gx, gy);
+}
+
+static __m256 Fade8(__m256 t)
+{
+    __m256 inner = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f));
+    inner = _mm256_add_ps(_mm256_mul_ps(t, inner), _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+}
+
+static __m256 Lerp8(__m256 a, __m256 b, __m256 t)
+{
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+static int Gradient2DSimd(const float* xs, const float* ys, float* out, int count, uint32_t seed)
+{
+    const __m256i seedVec = _mm256_set1_epi32(static_cast<int>(seed));
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 oneF = _mm256_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(xs + i);
+        const __m256 y = _mm256_loadu_ps(ys + i);
+        const __m256 x0 = _mm256_floor_ps(x);
+        const __m256 y0 = _mm256_floor_ps(y);
+        const __m256i ix = _mm256_cvttps_epi32(x0);
+        const __m256i iy = _mm256_cvttps_epi32(y0);
+        const __m256 fx = _mm256_sub_ps(x, x0);
+        const __m256 fy = _mm256_sub_ps(y, y0);
+        const __m256 fx1 = _mm256_sub_ps(fx, oneF);
+        const __m256 fy1 = _mm256_sub_ps(fy, oneF);
+        const __m256i ix1 = _mm256_add_epi32(ix, one);
+        const __m256i iy1 = _mm256_add_epi32(iy, one);
+
+        const __m256 n00 = GradientDot8(HashLattice8(ix, iy, seedVec), fx, fy);
+        const __m256 n10 = GradientDot8(HashLattice8(ix1, iy, seedVec), fx1, fy);
+        const __m256 n01 = GradientDot8(HashLattice8(ix, iy1, seedVec), fx, fy1);
+        const __m256 n11 = GradientDot8(HashLattice8(ix1, iy1, seedVec), fx1, fy1);
+
+        const __m256 u = Fade8(fx);
+        const __m256 v = Fade8(fy);
+        _mm256_storeu_ps(out + i, Lerp8(Lerp8(n00, n10, u), Lerp8(n01, n11, u), v));
+    }
+    return i;
+}
+
+#elif NOISE_SSE2
+
+// SSE2 has no 32-bit low multiply; build it from two 32x32->64 multiplies
+static __m128i MulLo32(__m128i a, __m128i b)
+{
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// SSE2 has no floor either: truncate, then step down where truncation rounded up
+static void Floor4(__m128 x, __m128& outFloor, __m128i& outInt)
+{
+    const __m128i truncated = _mm_cvttps_epi32(x);
+    const __m128 truncatedF = _mm_cvtepi32_ps(truncated);
+    const __m128 roundedUp = _mm_cmplt_ps(x, truncatedF);
+    outFloor = _mm_sub_ps(truncatedF, _mm_and_ps(roundedUp, _mm_set1_ps(1.0f)));
+    outInt = _mm_add_epi32(truncated, _mm_castps_si128(roundedUp));
+}
+
+static __m128i HashLattice4(__m128i ix, __m128i iy, __m128i seed)
+{
+    __m128i h = _mm_xor_si128(seed, MulLo32(ix, _mm_set1_epi32(static_cast<int>(s_PrimeX))));
+    h = _mm_xor_si128(h, MulLo32(iy, _mm_set1_epi32(static_cast<int>(s_PrimeY))));
+    h = MulLo32(_mm_xor_si128(h, _mm_srli_epi32(h, 15)), _mm_set1_epi32(static_cast<int>(s_HashMix)));
+    return _mm_xor_si128(h, _mm_srli_epi32(h, 13));
+}
+
+static __m128 GradientDot4(__m128i h, __m128 fx, __m128 fy)
+{
+    const __m128 gx = _mm_xor_ps(fx, _mm_castsi128_ps(_mm_slli_epi32(h, 31)));
+    const __m128 gy = _mm_xor_ps(fy, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30)));
+    return _mm_add_ps(gx, gy);
+}
+
+static __m128 Fade4(__m128 t)
+{
+    __m128 inner = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f));
+    inner = _mm_add_ps(_mm_mul_ps(t, inner), _mm_set1_ps(10.0f));
+    return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inner);
+}
+
+static __m128 Lerp4(__m128 a, __m128 b, __m128 t)
+{
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+static int Gradient2DSimd(const float* xs, const float* ys, float* out, int count, uint32_t seed)
+{
+    const __m128i seedVec = _mm_set1_epi32(static_cast<int>(seed));
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128 oneF = _mm_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(xs + i);
+        const __m128 y = _mm_loadu_ps(ys + i);
+        __m128 x0, y0;
+        __m128i ix, iy;
+        Floor4(x, x0, ix);
+        Floor4(y, y0, iy);
+        const __m128 fx = _mm_sub_ps(x, x0);
+        const __m128 fy = _mm_sub_ps(y, y0);
+        const __m128 fx1 = _mm_sub_ps(fx, oneF);
+        const __m128 fy1 = _mm_sub_ps(fy, oneF);
+        const __m128i ix1 = _mm_add_epi32(ix, one);
+        const __m128i iy1 = _mm_add_epi32(iy, one);
+
+        const __m128 n00 = GradientDot4(HashLattice4(ix, iy, seedVec), fx, fy);
+        const __m128 n10 = GradientDot4(HashLattice4(ix1, iy, seedVec), fx1, fy);
+        const __m128 n01 = GradientDot4(HashLattice4(ix, iy1, seedVec), fx, fy1);
+        const __m128 n11 = GradientDot4(HashLattice4(ix1, iy1, seedVec), fx1, fy1);
+
+        const __m128 u = Fade4(fx);
+        const __m128 v = Fade4(fy);
+        _mm_storeu_ps(out + i, Lerp4(Lerp4(n00, n10, u), Lerp4(n01, n11, u), v));
+    }
+    return i;
+}
+
+#endif
+
+void Noise::Gradient2DBatch(const float* xs, const float* ys, float* out, int count, uint32_t seed, NoiseKernel kernel)
+{
+    int i = 0;
+#if NOISE_AVX2 || NOISE_SSE2
+    if (kernel == NoiseKernel::Simd)
+        i = Gradient2DSimd(xs, ys, out, count, seed);
+#endif
+
+    // Reference path, and the tail the vector kernel leaves over
+    for (; i < count; ++i)
+    {
+        out[i] = Gradient2D(xs[i], ys[i], seed);
+    }
+}
+
+void Noise::Fbm2DBatch(const float* xs, const float* ys, float* out, int count, uint32_t seed,
+                       int octaves, float frequency, NoiseKernel kernel)
+{
+    assert(count <= MaxBatchSize);
+    float scaledX[MaxBatchSize];
+    float scaledY[MaxBatchSize];
+    float octave[MaxBatchSize];
+
+    std::fill_n(out, count, 0.0f);
+    float amplitude = 1.0f;
+    float totalAmplitude = 0.0f;
+    for (int o = 0; o < octaves; ++o)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            scaledX[i] = xs[i] * frequency;
+            scaledY[i] = ys[i] * frequency;
+        }
+        Gradient2DBatch(scaledX, scaledY, octave, count, seed + static_cast<uint32_t>(o) * s_OctaveSeedStep, kernel);
+        for (int i = 0; i < count; ++i)
+        {
+            out[i] += octave[i] * amplitude;
+        }
+
+        totalAmplitude += amplitude;
+        amplitude *= 0.5f;
+        frequency *= 2.0f;
+    }
+
+    const float scale = 1.0f / totalAmplitude;
+    for (int i = 0; i < count; ++i)
+    {
+        out[i] *= scale;
+    }
+}
+
+void Noise::Ridged2DBatch(const float* xs, const float* ys, float* out, int count, uint32_t seed,
+                          int octaves, float frequency, NoiseKernel kernel)
+{
+    assert(count <= MaxBatchSize);
+    float scaledX[MaxBatchSize];
+    float scaledY[MaxBatchSize];
+    float octave[MaxBatchSize];
+
+    std::fill_n(out, count, 0.0f);
+    float amplitude = 1.0f;
+    float totalAmplitude = 0.0f;
+    for (int o = 0; o < octaves; ++o)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            scaledX[i] = xs[i] * frequency;
+            scaledY[i] = ys[i] * frequency;
+        }
+        Gradient2DBatch(scaledX, scaledY, octave, count, seed + static_cast<uint32_t>(o) * s_OctaveSeedStep, kernel);
+        for (int i = 0; i < count; ++i)
+        {
+            float ridge = 1.0f - std::fabs(octave[i]);
+            out[i] += (ridge * ridge) * amplitude;
+        }
+
+        totalAmplitude += amplitude;
+        amplitude *= 0.5f;
+        frequency *= 2.0f;
+    }
+
+    const float scale = 1.0f / totalAmplitude;
+    for (int i = 0; i < count; ++i)
+    {
+        out[i] *= scale;
+    }
+}
+
+const char* Noise::GetSimdKernelName()
+{
+#if NOISE_AVX2
+    return "AVX2";
+#elif NOISE_SSE2
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Which implementation evaluates noise batches. Both produce bit-identical results;
+// Scalar is the reference the vectorized kernel is checked against.
+enum class NoiseKernel : uint8_t
+{
+    Scalar = 0,
+    Simd        // AVX2 or SSE2 when the compiler targets them, otherwise the scalar loop
+};
+
+// Seeded 2D gradient noise, evaluated one point at a time (reference) or over whole
+// batches of points such as the columns of a chunk. Output is roughly in [-1, 1].
+// Bit-exactness relies on the compiler not contracting a * b + c into FMA instructions.
+class Noise
+{
+public:
+    static constexpr int MaxBatchSize = 256;    // One 16x16 chunk column layer
+
+    static float Gradient2D(float x, float y, uint32_t seed);
+    static void Gradient2DBatch(const float* xs, const float* ys, float* out, int count, uint32_t seed, NoiseKernel kernel);
+
+    // Fractal sums of the batch kernel. Fbm is normalized to roughly [-1, 1],
+    // Ridged to [0, 1] with sharp crests where the underlying noise crosses zero.
+    static void Fbm2DBatch(const float* xs, const float* ys, float* out, int count, uint32_t seed,
+                           int octaves, float frequency, NoiseKernel kernel);
+    static void Ridged2DBatch(const float* xs, const float* ys, float* out, int count, uint32_t seed,
+                              int octaves, float frequency, NoiseKernel kernel);
+
+    static const char* GetSimdKernelName();
+};
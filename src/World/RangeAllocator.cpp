@@ -0,0 +1,97 @@
+#include "RangeAllocator.h"
+#include <algorithm>
+
+uint32_t RangeAllocator::Allocate(uint32_t size)
+{
+    if (size == 0)
+        return InvalidOffset;
+
+    // Best fit: the smallest free range that can hold the request
+    size_t best = m_FreeRanges.size();
+    for (size_t i = 0; i < m_FreeRanges.size(); ++i)
+    {
+        uint32_t rangeSize = m_FreeRanges[i].Size;
+        if (rangeSize >= size && (best == m_FreeRanges.size() || rangeSize < m_FreeRanges[best].Size))
+        {
+            best = i;
+            if (rangeSize == size)
+                break;
+        }
+    }
+    if (best == m_FreeRanges.size())
+        return InvalidOffset;
+
+    // Hand out the head of the range and keep the tail free
+    FreeRange& range = m_FreeRanges[best];
+    uint32_t offset = range.Offset;
+    if (range.Size > size)
+    {
+        range.Offset += size;
+        range.Size -= size;
+    }
+    else
+    {
+        m_FreeRanges.erase(m_FreeRanges.begin() + best);
+    }
+
+    m_FreeTotal -= size;
+    return offset;
+}
+
+void RangeAllocator::Free(uint32_t offset, uint32_t size)
+{
+    if (size == 0 || offset == InvalidOffset)
+        return;
+
+    m_FreeTotal += size;
+
+    // First free range after the freed one
+    auto nextIt = std::lower_bound(m_FreeRanges.begin(), m_FreeRanges.end(), offset,
+                                   [](const FreeRange& range, uint32_t value) { return range.Offset < value; });
+    bool mergesNext = nextIt != m_FreeRanges.end() && nextIt->Offset == offset + size;
+    bool mergesPrev = nextIt != m_FreeRanges.begin() && (nextIt - 1)->Offset + (nextIt - 1)->Size == offset;
+
+    if (mergesPrev && mergesNext)
+    {
+        (nextIt - 1)->Size += size + nextIt->Size;
+        m_FreeRanges.erase(nextIt);
+    }
+    else if (mergesPrev)
+    {
+        (nextIt - 1)->Size += size;
+    }
+    else if (mergesNext)
+    {
+        nextIt->Offset = offset;
+        nextIt->Size += size;
+    }
+    else
+    {
+        m_FreeRanges.insert(nextIt, FreeRange{offset, size});
+    }
+}
+
+void RangeAllocator::Reset(uint32_t capacity)
+{
+    m_Capacity = capacity;
+    m_FreeTotal = capacity;
+    m_FreeRanges.clear();
+    m_FreeRanges.reserve(InitialRangeCapacity);
+    if (capacity > 0)
+        m_FreeRanges.push_back(FreeRange{0, capacity});
+}
+
+uint32_t RangeAllocator::GetLargestFreeRange() const
+{
+    uint32_t largest = 0;
+    for (const FreeRange& range : m_FreeRanges)
+        largest = std::max(largest, range.Size);
+    return largest;
+}
+
+float RangeAllocator::GetFragmentation() const
+{
+    if (m_FreeTotal == 0)
+        return 0.0f;
+    return 1.0f - static_cast<float>(GetLargestFreeRange()) / static_cast<float>(m_FreeTotal);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sub-allocates [offset, offset + size) ranges out of a fixed capacity.
+// Free ranges are kept in one vector sorted by offset: a free finds its neighbours by binary
+// search to coalesce with them, and an allocation takes the best fit in a linear scan. Holes
+// stay few because the geometry pool compacts splintered pages, and the vector keeps its
+// capacity, so allocating and freeing don't touch the heap once it has seen its peak hole count.
+class RangeAllocator
+{
+public:
+    static constexpr uint32_t InvalidOffset = UINT32_MAX;
+
+    explicit RangeAllocator(uint32_t capacity = 0) { Reset(capacity); }
+
+    // Returns InvalidOffset if no single free range is large enough
+    uint32_t Allocate(uint32_t size);
+    void Free(uint32_t offset, uint32_t size);
+
+    // Drops every allocation
+    void Reset(uint32_t capacity);
+
+    uint32_t GetCapacity() const { return m_Capacity; }
+    uint32_t GetUsed() const { return m_Capacity - m_FreeTotal; }
+    uint32_t GetFreeTotal() const { return m_FreeTotal; }
+    uint32_t GetLargestFreeRange() const;
+    size_t GetFreeRangeCount() const { return m_FreeRanges.size(); }
+
+    // 0 when all free space is one range, approaching 1 as it splinters into small holes
+    float GetFragmentation() const;
+
+private:
+    // Reserved up front; well past the hole count at which the geometry pool compacts a page
+    static constexpr size_t InitialRangeCapacity = 256;
+
+    struct FreeRange
+    {
+        uint32_t Offset;
+        uint32_t Size;
+    };
+
+    uint32_t m_Capacity = 0;
+    uint32_t m_FreeTotal = 0;
+    std::vector<FreeRange> m_FreeRanges;     // Sorted by offset, never adjacent
+};
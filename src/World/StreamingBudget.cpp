@@ -0,0 +1,57 @@
+#include "StreamingBudget.h"
+#include <algorithm>
+
+// Moving-average weight of the newest sample
+static constexpr double s_CostSmoothing = 0.1;
+static constexpr double s_ThroughputSmoothing = 0.05;
+
+// Budget adjustment per frame: back off hard on a long frame, creep up otherwise
+static constexpr double s_BudgetDecrease = 0.75;
+static constexpr double s_BudgetIncreaseMs = 0.1;
+static constexpr double s_FrameTimeTolerance = 1.05;
+
+void StreamingBudget::BeginFrame(double frameTimeMs)
+{
+    if (frameTimeMs > m_TargetFrameTimeMs * s_FrameTimeTolerance)
+        m_BudgetMs *= s_BudgetDecrease;
+    else
+        m_BudgetMs += s_BudgetIncreaseMs;
+    m_BudgetMs = std::min(std::max(m_BudgetMs, MinBudgetMs), MaxBudgetMs);
+
+    for (int op = 0; op < OpCount; ++op)
+    {
+        if (frameTimeMs > 0.0)
+        {
+            double opsPerSecond = m_Ops[op] * 1000.0 / frameTimeMs;
+            m_Throughput[op] += (opsPerSecond - m_Throughput[op]) * s_ThroughputSmoothing;
+        }
+        m_OpsLastFrame[op] = m_Ops[op];
+        m_Ops[op] = 0;
+    }
+    m_UsedMsLastFrame = m_UsedMs;
+    m_UsedMs = 0.0;
+}
+
+bool StreamingBudget::HasBudget(StreamingOp op) const
+{
+    const int index = static_cast<int>(op);
+    return m_Ops[index] == 0 || m_UsedMs + m_AverageCostMs[index] <= m_BudgetMs;
+}
+
+void StreamingBudget::Record(StreamingOp op, Clock::time_point startTime)
+{
+    const int index = static_cast<int>(op);
+    const double costMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+
+    m_UsedMs += costMs;
+    m_Ops[index]++;
+    m_AverageCostMs[index] += (costMs - m_AverageCostMs[index]) * s_CostSmoothing;
+}
+
+double StreamingBudget::GetDrainEta(StreamingOp op, size_t pendingCount) const
+{
+    const double throughput = m_Throughput[static_cast<int>(op)];
+    if (pendingCount == 0)
+        return 0.0;
+    return throughput > 0.0 ? pendingCount / throughput : -1.0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Kinds of main-thread streaming work charged against the frame budget
+enum class StreamingOp : uint8_t
+{
+    Integrate = 0,  // Insert a generated chunk into the world
+    Mesh,           // Build a chunk mesh from its snapshot
+    Upload,         // Copy a mesh into the geometry pool
+    Unload,         // Free a chunk or its GPU geometry
+    Count
+};
+
+// Per-frame millisecond budget for main-thread streaming work.
+// The budget adapts to hold a target frame time: it shrinks multiplicatively when frames run
+// long and grows additively while they don't. Each operation kind keeps a moving average of
+// its measured cost, and work is admitted only while that estimate still fits in the budget.
+// Every kind gets at least one operation per frame, so no stage of the pipeline starves.
+class StreamingBudget
+{
+public:
+    using Clock = std::chrono::high_resolution_clock;
+
+    static constexpr double MinBudgetMs = 0.5;
+    static constexpr double MaxBudgetMs = 8.0;
+
+    void SetTargetFrameTime(double milliseconds) { m_TargetFrameTimeMs = milliseconds; }
+    double GetTargetFrameTime() const { return m_TargetFrameTimeMs; }
+
+    // Start of a frame; frameTimeMs is how long the previous frame took
+    void BeginFrame(double frameTimeMs);
+
+    bool HasBudget(StreamingOp op) const;
+    void Record(StreamingOp op, Clock::time_point startTime);
+
+    double GetBudgetMs() const { return m_BudgetMs; }
+    double GetUsedMsLastFrame() const { return m_UsedMsLastFrame; }
+    double GetAverageCostMs(StreamingOp op) const { return m_AverageCostMs[static_cast<int>(op)]; }
+    size_t GetOpsLastFrame(StreamingOp op) const { return m_OpsLastFrame[static_cast<int>(op)]; }
+
+    // Smoothed operations per second, and the seconds it would take to drain pendingCount at that rate
+    double GetThroughput(StreamingOp op) const { return m_Throughput[static_cast<int>(op)]; }
+    double GetDrainEta(StreamingOp op, size_t pendingCount) const;
+
+private:
+    static constexpr int OpCount = static_cast<int>(StreamingOp::Count);
+
+    double m_TargetFrameTimeMs = 1000.0 / 60.0;
+    double m_BudgetMs = 2.0;
+    double m_UsedMs = 0.0;
+    double m_UsedMsLastFrame = 0.0;
+
+    double m_AverageCostMs[OpCount] = {};
+    double m_Throughput[OpCount] = {};
+    size_t m_Ops[OpCount] = {};
+    size_t m_OpsLastFrame[OpCount] = {};
+};
@@ -0,0 +1,97 @@
+#include "StreamingVolume.h"
+#include <algorithm>
+
+static const int s_Directions[StreamingVolume::DirectionCount][3] = {
+    {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+};
+
+int StreamingVolume::GetDirectionIndex(int dx, int dy, int dz)
+{
+    for (int direction = 0; direction < DirectionCount; ++direction)
+    {
+        if (s_Directions[direction][0] == dx && s_Directions[direction][1] == dy && s_Directions[direction][2] == dz)
+            return direction;
+    }
+    return -1;
+}
+
+bool StreamingVolume::SetShape(StreamingShape shape, int horizontalRadius, int verticalRadius, int unloadMargin)
+{
+    if (shape == m_Shape && horizontalRadius == m_HorizontalRadius && verticalRadius == m_VerticalRadius && unloadMargin == m_UnloadMargin)
+        return false;
+
+    m_Shape = shape;
+    m_HorizontalRadius = horizontalRadius;
+    m_VerticalRadius = verticalRadius;
+    m_UnloadMargin = unloadMargin;
+
+    m_LoadOffsets.clear();
+    for (int direction = 0; direction < DirectionCount; ++direction)
+    {
+        m_EnteringLoad[direction].clear();
+        m_LeavingLoad[direction].clear();
+        m_LeavingUnload[direction].clear();
+    }
+
+    // One pass over the bounding cube (plus one chunk for the move) classifies every offset.
+    // The player moved by d, so an offset o from the new chunk was o + d from the old one.
+    const int horizontalExtent = m_HorizontalRadius + m_UnloadMargin + 1;
+    const int verticalExtent = m_VerticalRadius + m_UnloadMargin + 1;
+    for (int x = -horizontalExtent; x <= horizontalExtent; ++x)
+    {
+        for (int y = -verticalExtent; y <= verticalExtent; ++y)
+        {
+            for (int z = -horizontalExtent; z <= horizontalExtent; ++z)
+            {
+                const ChunkOffset offset{x, y, z};
+                const bool inLoad = IsInsideLoadRadius(x, y, z);
+                const bool inUnload = IsInsideUnloadRadius(x, y, z);
+
+                if (inLoad)
+                    m_LoadOffsets.push_back(offset);
+
+                for (int direction = 0; direction < DirectionCount; ++direction)
+                {
+                    const int ox = x + s_Directions[direction][0];
+                    const int oy = y + s_Directions[direction][1];
+                    const int oz = z + s_Directions[direction][2];
+                    const bool wasInLoad = IsInsideLoadRadius(ox, oy, oz);
+
+                    if (inLoad && !wasInLoad)
+                        m_EnteringLoad[direction].push_back(offset);
+                    if (!inLoad && wasInLoad)
+                        m_LeavingLoad[direction].push_back(offset);
+                    if (!inUnload && IsInsideUnloadRadius(ox, oy, oz))
+                        m_LeavingUnload[direction].push_back(offset);
+                }
+            }
+        }
+    }
+
+    std::sort(m_LoadOffsets.begin(), m_LoadOffsets.end(), [](const ChunkOffset& a, const ChunkOffset& b) {
+        return a.x * a.x + a.y * a.y + a.z * a.z < b.x * b.x + b.y * b.y + b.z * b.z;
+    });
+    return true;
+}
+
+bool StreamingVolume::IsInsideLoadRadius(int dx, int dy, int dz) const
+{
+    return IsInside(dx, dy, dz, m_HorizontalRadius, m_VerticalRadius);
+}
+
+bool StreamingVolume::IsInsideUnloadRadius(int dx, int dy, int dz) const
+{
+    return IsInside(dx, dy, dz, m_HorizontalRadius + m_UnloadMargin, m_VerticalRadius + m_UnloadMargin);
+}
+
+bool StreamingVolume::IsInside(int dx, int dy, int dz, int horizontalRadius, int verticalRadius) const
+{
+    const int horizontal = dx * dx + dz * dz;
+    const int h2 = horizontalRadius * horizontalRadius;
+    const int v2 = verticalRadius * verticalRadius;
+    if (m_Shape == StreamingShape::Cylinder)
+        return horizontal <= h2 && dy * dy <= v2;
+
+    // (x^2 + z^2) / h^2 + y^2 / v^2 <= 1, scaled by h^2 * v^2 to stay in integers
+    return horizontal * v2 + dy * dy * h2 <= h2 * v2;
+}
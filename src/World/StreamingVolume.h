@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Chunk offset relative to the player's chunk
+struct ChunkOffset
+{
+    int x, y, z;
+};
+
+// Shape of the streamed volume; both use separate horizontal (X/Z) and vertical (Y) radii
+enum class StreamingShape : uint8_t
+{
+    Ellipsoid = 0,
+    Cylinder,       // Vertical cylinder: horizontal radius around the player, capped at the vertical radius above and below
+    Count
+};
+
+// The set of chunk offsets streamed around the player, plus precomputed shell deltas.
+// For each one-chunk move along an axis, the chunks that enter or leave the volume are
+// looked up from these lists instead of rescanning the whole volume.
+class StreamingVolume
+{
+public:
+    // Unit move directions: +X, -X, +Y, -Y, +Z, -Z
+    static constexpr int DirectionCount = 6;
+    static int GetDirectionIndex(int dx, int dy, int dz);
+
+    // Rebuilds the offsets and shell deltas; returns false if nothing changed
+    bool SetShape(StreamingShape shape, int horizontalRadius, int verticalRadius, int unloadMargin);
+    StreamingShape GetShape() const { return m_Shape; }
+    int GetHorizontalRadius() const { return m_HorizontalRadius; }
+    int GetVerticalRadius() const { return m_VerticalRadius; }
+
+    bool IsInsideLoadRadius(int dx, int dy, int dz) const;
+    bool IsInsideUnloadRadius(int dx, int dy, int dz) const;
+
+    // All offsets inside the load radius, nearest first
+    const std::vector<ChunkOffset>& GetLoadOffsets() const { return m_LoadOffsets; }
+
+    // Shell deltas for a one-chunk move; offsets are relative to the new player chunk
+    const std::vector<ChunkOffset>& GetEnteringLoad(int direction) const { return m_EnteringLoad[direction]; }
+    const std::vector<ChunkOffset>& GetLeavingLoad(int direction) const { return m_LeavingLoad[direction]; }
+    const std::vector<ChunkOffset>& GetLeavingUnload(int direction) const { return m_LeavingUnload[direction]; }
+
+private:
+    StreamingShape m_Shape = StreamingShape::Ellipsoid;
+    int m_HorizontalRadius = -1;
+    int m_VerticalRadius = -1;
+    int m_UnloadMargin = 0;
+
+    bool IsInside(int dx, int dy, int dz, int horizontalRadius, int verticalRadius) const;
+
+    std::vector<ChunkOffset> m_LoadOffsets;
+    std::vector<ChunkOffset> m_EnteringLoad[DirectionCount];
+    std::vector<ChunkOffset> m_LeavingLoad[DirectionCount];
+    std::vector<ChunkOffset> m_LeavingUnload[DirectionCount];
+};
@@ -0,0 +1,88 @@
+#include "TerrainColumnCache.h"
+#include <algorithm>
+#include <atomic>
+
+TerrainColumnCache::TerrainColumnCache(const WorldGenerator& generator, size_t memoryBudget)
+    : m_Generator(generator), m_MemoryBudget(memoryBudget)
+{
+}
+
+std::shared_ptr<const TerrainColumn> TerrainColumnCache::GetColumn(int chunkX, int chunkZ)
+{
+    const int64_t key = GetColumnKey(chunkX, chunkZ);
+    ColumnPtr column;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (ColumnPtr* cached = m_Entries.Touch(key))
+        {
+            m_Hits++;
+            return *cached;
+        }
+        m_Misses++;
+        column = AcquireColumn();
+    }
+
+    // Evaluate the noise without holding the lock, so other workers keep hitting the cache
+    m_Generator.GenerateColumn(chunkX, chunkZ, *column);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (ColumnPtr* cached = m_Entries.Touch(key))
+    {
+        // Another worker generated the same column meanwhile; both copies are identical
+        m_FreeColumns.push_back(std::move(column));
+        return *cached;
+    }
+
+    m_Entries.Insert(key) = column;
+
+    const size_t maxEntries = std::max<size_t>(m_MemoryBudget / EntryBytes, 1);
+    while (m_Entries.Size() > maxEntries)
+    {
+        // Still in use by a worker: that worker's reference frees it instead. Once evicted no one
+        // can take a new reference, so a count of one stays one; the fence orders the last
+        // holder's reads before our rewrite of the column.
+        ColumnPtr evicted = m_Entries.RemoveOldest();
+        if (evicted.use_count() == 1)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            m_FreeColumns.push_back(std::move(evicted));
+        }
+        m_Evictions++;
+    }
+    return column;
+}
+
+void TerrainColumnCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.Clear();
+    m_FreeColumns.clear();
+}
+
+TerrainColumnCacheStats TerrainColumnCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    TerrainColumnCacheStats stats;
+    stats.Columns = m_Entries.Size();
+    stats.MemoryBytes = m_Entries.Size() * EntryBytes;
+    stats.Hits = m_Hits;
+    stats.Misses = m_Misses;
+    stats.Evictions = m_Evictions;
+    return stats;
+}
+
+int64_t TerrainColumnCache::GetColumnKey(int chunkX, int chunkZ)
+{
+    return MakeChunkKey(chunkX, 0, chunkZ);
+}
+
+// Called with m_Mutex held
+TerrainColumnCache::ColumnPtr TerrainColumnCache::AcquireColumn()
+{
+    if (m_FreeColumns.empty())
+        return std::make_shared<TerrainColumn>();
+
+    ColumnPtr column = std::move(m_FreeColumns.back());
+    m_FreeColumns.pop_back();
+    return column;
+}
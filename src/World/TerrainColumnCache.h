@@ -0,0 +1,62 @@
+#pragma once
+
+#include "WorldGenerator.h"
+#include "ChunkLru.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct TerrainColumnCacheStats
+{
+    size_t Columns = 0;
+    size_t MemoryBytes = 0;
+    size_t Hits = 0;
+    size_t Misses = 0;
+    size_t Evictions = 0;
+};
+
+// LRU cache of generated terrain columns keyed by chunk X/Z, shared by the generation workers.
+// Columns are handed out as shared pointers, so evicting one never pulls it from under a
+// worker still generating from it. A miss is generated outside the lock; two workers missing
+// the same column at once both generate it and the second copy is dropped. Evicted columns no
+// worker holds any more are generated into again, so a full cache stops allocating.
+class TerrainColumnCache
+{
+public:
+    static constexpr size_t DefaultMemoryBudget = 8 * 1024 * 1024;
+
+    explicit TerrainColumnCache(const WorldGenerator& generator, size_t memoryBudget = DefaultMemoryBudget);
+
+    TerrainColumnCache(const TerrainColumnCache&) = delete;
+    TerrainColumnCache& operator=(const TerrainColumnCache&) = delete;
+
+    std::shared_ptr<const TerrainColumn> GetColumn(int chunkX, int chunkZ);
+    void Clear();
+
+    const WorldGenerator& GetGenerator() const { return m_Generator; }
+    size_t GetMemoryBudget() const { return m_MemoryBudget; }
+    TerrainColumnCacheStats GetStats() const;
+
+private:
+    using ColumnPtr = std::shared_ptr<TerrainColumn>;
+
+    // Approximate footprint of one cached column, including its LRU entry
+    static constexpr size_t EntryBytes = sizeof(TerrainColumn) + sizeof(ColumnPtr) + 64;
+
+    static int64_t GetColumnKey(int chunkX, int chunkZ);
+    ColumnPtr AcquireColumn();
+
+    const WorldGenerator& m_Generator;
+    size_t m_MemoryBudget;
+
+    // Most recently used at the front
+    ChunkLru<ColumnPtr> m_Entries;
+    std::vector<ColumnPtr> m_FreeColumns;
+    mutable std::mutex m_Mutex;
+
+    size_t m_Hits = 0;
+    size_t m_Misses = 0;
+    size_t m_Evictions = 0;
+};
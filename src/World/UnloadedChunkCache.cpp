@@ -0,0 +1,73 @@
+#include "UnloadedChunkCache.h"
+
+UnloadedChunkCache::UnloadedChunkCache(size_t memoryBudget)
+    : m_MemoryBudget(memoryBudget)
+{
+}
+
+void UnloadedChunkCache::Insert(ChunkPtr chunk)
+{
+    const int64_t key = MakeChunkKey(chunk->GetChunkX(), chunk->GetChunkY(), chunk->GetChunkZ());
+    if (m_Entries.Find(key) != nullptr)
+        m_MemoryBytes -= m_Entries.Remove(key).MemoryBytes;
+
+    Entry& entry = m_Entries.Insert(key);
+    entry.MemoryBytes = chunk->GetMemoryUsage() + sizeof(Entry);
+    entry.ChunkData = std::move(chunk);
+    m_MemoryBytes += entry.MemoryBytes;
+
+    EvictToBudget();
+}
+
+ChunkPtr UnloadedChunkCache::Take(const ChunkCoordinate& coord)
+{
+    const int64_t key = MakeChunkKey(coord.x, coord.y, coord.z);
+    if (m_Entries.Find(key) == nullptr)
+    {
+        m_Misses++;
+        return nullptr;
+    }
+
+    m_Hits++;
+    Entry entry = m_Entries.Remove(key);
+    m_MemoryBytes -= entry.MemoryBytes;
+    return std::move(entry.ChunkData);
+}
+
+Chunk* UnloadedChunkCache::Find(const ChunkCoordinate& coord) const
+{
+    const Entry* entry = m_Entries.Find(MakeChunkKey(coord.x, coord.y, coord.z));
+    return entry != nullptr ? entry->ChunkData.get() : nullptr;
+}
+
+void UnloadedChunkCache::Clear()
+{
+    m_Entries.Clear();
+    m_MemoryBytes = 0;
+}
+
+void UnloadedChunkCache::SetMemoryBudget(size_t memoryBudget)
+{
+    m_MemoryBudget = memoryBudget;
+    EvictToBudget();
+}
+
+UnloadedChunkCacheStats UnloadedChunkCache::GetStats() const
+{
+    UnloadedChunkCacheStats stats;
+    stats.Chunks = m_Entries.Size();
+    stats.MemoryBytes = m_MemoryBytes;
+    stats.Hits = m_Hits;
+    stats.Misses = m_Misses;
+    stats.Evictions = m_Evictions;
+    return stats;
+}
+
+void UnloadedChunkCache::EvictToBudget()
+{
+    while (m_MemoryBytes > m_MemoryBudget && !m_Entries.Empty())
+    {
+        m_MemoryBytes -= m_Entries.RemoveOldest().MemoryBytes;
+        m_Evictions++;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ChunkPool.h"
+#include "ChunkCoordinate.h"
+#include "ChunkLru.h"
+#include <cstddef>
+
+struct UnloadedChunkCacheStats
+{
+    size_t Chunks = 0;
+    size_t MemoryBytes = 0;
+    size_t Hits = 0;
+    size_t Misses = 0;
+    size_t Evictions = 0;
+};
+
+// LRU cache of chunks recently unloaded from the world, kept whole: palette-compressed blocks
+// plus the CPU mesh they were last built with. A chunk that comes back into range is restored
+// from here without generation or meshing. Main thread only.
+class UnloadedChunkCache
+{
+public:
+    static constexpr size_t DefaultMemoryBudget = 32 * 1024 * 1024;
+
+    explicit UnloadedChunkCache(size_t memoryBudget = DefaultMemoryBudget);
+
+    UnloadedChunkCache(const UnloadedChunkCache&) = delete;
+    UnloadedChunkCache& operator=(const UnloadedChunkCache&) = delete;
+
+    void Insert(ChunkPtr chunk);
+    ChunkPtr Take(const ChunkCoordinate& coord);    // Counts a hit or a miss
+    Chunk* Find(const ChunkCoordinate& coord) const;                // No stats, no LRU touch
+    void Clear();
+
+    void SetMemoryBudget(size_t memoryBudget);
+    size_t GetMemoryBudget() const { return m_MemoryBudget; }
+    UnloadedChunkCacheStats GetStats() const;
+
+private:
+    struct Entry
+    {
+        ChunkPtr ChunkData;
+        size_t MemoryBytes = 0;
+    };
+
+    void EvictToBudget();
+
+    size_t m_MemoryBudget;
+    size_t m_MemoryBytes = 0;
+
+    // Most recently unloaded at the front
+    ChunkLru<Entry> m_Entries;
+
+    size_t m_Hits = 0;
+    size_t m_Misses = 0;
+    size_t m_Evictions = 0;
+};
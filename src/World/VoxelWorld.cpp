@@ -1,38 +1,250 @@
 #include "VoxelWorld.h"
+#include "../Core/AllocationCounter.h"
+#include "../Core/Profiler.h"
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <random>
 
-VoxelWorld::VoxelWorld()
-    : m_LastPlayerPosition(0, 0, 0), m_RenderDistance(16), 
+// Neighbor chunk offsets in BlockFace order (Top, Bottom, Right, Left, Front, Back)
+static const int s_NeighborOffsets[6][3] = {
+    {0, 1, 0}, {0, -1, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 0, 1}, {0, 0, -1}
+};
+
+// Priority added per squared chunk layer between a chunk and its column's surface band
+static const int s_SurfaceBandPenalty = 16;
+
+// Predictive prefetch: how far ahead the trajectory is extrapolated, how quickly the velocity
+// estimate follows the player, how much cheaper a chunk on the path is than one at the same
+// distance off it, and how much dearer a chunk straight behind the view is than one in front
+static const float s_PrefetchLookaheadSeconds = 2.0f;
+static const float s_VelocitySmoothing = 0.1f;
+static const float s_OnPathWeight = 0.25f;
+static const float s_BehindViewPenalty = 0.5f;
+
+static int GetOppositeFace(int face)
+{
+    return face ^ 1;
+}
+
+VoxelWorld::VoxelWorld(uint64_t seed)
+    : m_ChunkPool(&m_MeshBuffers), m_Generator(seed), m_ColumnCache(m_Generator), m_LastPlayerPosition(0, 0, 0), m_RenderDistance(16), 
       m_LastPlayerChunkX(INT_MAX), m_LastPlayerChunkY(INT_MAX), m_LastPlayerChunkZ(INT_MAX)
 {
+    m_WorkerPool = std::make_unique<ChunkWorkerPool>(m_ColumnCache, m_ChunkPool);
 }
 
-void VoxelWorld::Update(const float3& playerPosition)
+void VoxelWorld::Update(const float3& playerPosition, const float3& viewDirection, double frameTimeMs)
 {
+    PROFILE_SCOPE("VoxelWorld::Update");
+    m_StreamingBudget.BeginFrame(frameTimeMs);
+    const uint64_t allocationsBefore = AllocationCounter::GetThreadAllocations();
+    
+    bool trajectoryChanged = UpdatePrefetch(playerPosition, viewDirection, frameTimeMs);
+    
     // Calculate current player chunk position
     int playerChunkX = static_cast<int>(std::floor(playerPosition.x / CHUNK_X_SIZE));
     int playerChunkY = static_cast<int>(std::floor(playerPosition.y / CHUNK_Y_SIZE));
     int playerChunkZ = static_cast<int>(std::floor(playerPosition.z / CHUNK_Z_SIZE));
     
+    // Render distance or shape changed: the shell deltas no longer apply, rebuild the volume and rescan
+    bool radiusChanged = m_StreamingVolume.SetShape(m_StreamingShape, m_RenderDistance, m_VerticalRenderDistance, 2);
+    
     // Check if player has moved to a new chunk
-    if (playerChunkX != m_LastPlayerChunkX || 
+    if (radiusChanged ||
+        playerChunkX != m_LastPlayerChunkX || 
         playerChunkY != m_LastPlayerChunkY || 
         playerChunkZ != m_LastPlayerChunkZ)
     {
-        // Player moved to a new chunk - queue all chunks around new position
-        m_LastPlayerChunkX = playerChunkX;
-        m_LastPlayerChunkY = playerChunkY;
-        m_LastPlayerChunkZ = playerChunkZ;
+        // A short move only touches the chunks on the edge of the volume; the first update,
+        // a radius change or a teleport of more than one chunk per axis rescans everything
+        bool fullRescan = radiusChanged || m_LastPlayerChunkX == INT_MAX ||
+                          std::abs(playerChunkX - m_LastPlayerChunkX) > 1 ||
+                          std::abs(playerChunkY - m_LastPlayerChunkY) > 1 ||
+                          std::abs(playerChunkZ - m_LastPlayerChunkZ) > 1;
+        
+        if (fullRescan)
+        {
+            m_LastPlayerChunkX = playerChunkX;
+            m_LastPlayerChunkY = playerChunkY;
+            m_LastPlayerChunkZ = playerChunkZ;
+            
+            QueueChunksAroundPlayer(playerPosition);
+            QueueChunksForDeletion(playerPosition);
+            
+            // The load radius moved wholesale: recheck everything waiting for a neighbor
+            for (const ChunkCoordinate& coord : m_DirtyChunks)
+                QueueMeshIfReady(coord);
+        }
+        else
+        {
+            // Diagonal moves are applied as one unit step per axis
+            if (playerChunkX != m_LastPlayerChunkX)
+                StreamShellDelta(playerChunkX - m_LastPlayerChunkX, 0, 0);
+            if (playerChunkY != m_LastPlayerChunkY)
+                StreamShellDelta(0, playerChunkY - m_LastPlayerChunkY, 0);
+            if (playerChunkZ != m_LastPlayerChunkZ)
+                StreamShellDelta(0, 0, playerChunkZ - m_LastPlayerChunkZ);
+        }
         m_LastPlayerPosition = playerPosition;
+        CancelStaleJobs();
+        PruneSurfaceBands();
+    }
+    
+    // Chunks ahead of the player may now be more urgent than when they were queued
+    if (trajectoryChanged)
+    {
+        m_LoadQueue.Reprioritize([this](const ChunkCoordinate& coord) { return GetChunkPriority(coord); });
+    }
+    
+    // Process queues each frame within the streaming budget; the renderer's uploads draw from the same budget
+    ProcessChunkQueue();
+    ProcessDirtyChunks();
+    ProcessDeletionQueue();
+    
+    // Everything this update allocated, plus what the workers allocated running its jobs
+    m_HeapAllocationsLastFrame = static_cast<size_t>(AllocationCounter::GetThreadAllocations() - allocationsBefore + m_WorkerPool->TakeJobAllocations());
+}
+
+void VoxelWorld::StreamShellDelta(int directionX, int directionY, int directionZ)
+{
+    int direction = StreamingVolume::GetDirectionIndex(directionX, directionY, directionZ);
+    
+    m_LastPlayerChunkX += directionX;
+    m_LastPlayerChunkY += directionY;
+    m_LastPlayerChunkZ += directionZ;
+    
+    // Chunks that just entered the load radius
+    for (const ChunkOffset& offset : m_StreamingVolume.GetEnteringLoad(direction))
+    {
+        ChunkCoordinate coord(m_LastPlayerChunkX + offset.x, m_LastPlayerChunkY + offset.y, m_LastPlayerChunkZ + offset.z);
+        if (GetChunk(coord.x, coord.y, coord.z) == nullptr && !m_InFlightChunks.Contains(coord))
+        {
+            m_LoadQueue.Push(coord, GetChunkPriority(coord));
+        }
+    }
+    
+    // Chunks that left the load radius before they were generated; chunks waiting to be
+    // meshed next to them no longer have to wait
+    for (const ChunkOffset& offset : m_StreamingVolume.GetLeavingLoad(direction))
+    {
+        ChunkCoordinate coord(m_LastPlayerChunkX + offset.x, m_LastPlayerChunkY + offset.y, m_LastPlayerChunkZ + offset.z);
+        m_LoadQueue.Remove(coord);
+        if (GetChunk(coord.x, coord.y, coord.z) == nullptr)
+            QueueReadyNeighbors(coord);
+    }
+    
+    // Loaded chunks that just left the unload radius
+    for (const ChunkOffset& offset : m_StreamingVolume.GetLeavingUnload(direction))
+    {
+        ChunkCoordinate coord(m_LastPlayerChunkX + offset.x, m_LastPlayerChunkY + offset.y, m_LastPlayerChunkZ + offset.z);
+        if (GetChunk(coord.x, coord.y, coord.z) != nullptr && m_QueuedForDeletion.Insert(coord))
+        {
+            m_ChunkDeletionQueue.Push(coord);
+        }
+    }
+}
+
+float VoxelWorld::GetChunkPriority(const ChunkCoordinate& coord) const
+{
+    float3 offset(static_cast<float>(coord.x - m_LastPlayerChunkX),
+                  static_cast<float>(coord.y - m_LastPlayerChunkY),
+                  static_cast<float>(coord.z - m_LastPlayerChunkZ));
+    float distanceSquared = dot(offset, offset);
+    float priority = distanceSquared;
+    
+    if (m_PredictivePrefetch)
+    {
+        // Distance to the predicted path, plus a discounted distance along it, so the chunks the
+        // player is heading into come before those at the same distance behind
+        float pathLengthSquared = dot(m_PrefetchOffset, m_PrefetchOffset);
+        if (pathLengthSquared > 0.0f)
+        {
+            float along = std::min(std::max(dot(offset, m_PrefetchOffset) / pathLengthSquared, 0.0f), 1.0f);
+            float3 offPath = offset - m_PrefetchOffset * along;
+            priority = dot(offPath, offPath) + s_OnPathWeight * along * along * pathLengthSquared;
+        }
         
-        QueueChunksAroundPlayer(playerPosition);
-        QueueChunksForDeletion(playerPosition);
+        // The chunks around the player are needed whichever way they look
+        if (distanceSquared > 1.0f)
+        {
+            float facing = dot(offset, m_ViewDirection) / std::sqrt(distanceSquared);
+            priority *= 1.0f + s_BehindViewPenalty * (1.0f - facing) * 0.5f;
+        }
     }
     
-    // Process queues each frame for smooth performance
-    ProcessChunkQueue(2); // Process 2 chunks per frame for generation
-    ProcessDeletionQueue(1); // Process 1 chunk per frame for deletion
+    // Columns none of whose chunks has been generated yet are unbiased
+    if (m_SurfaceBandBias)
+    {
+        if (const SurfaceBand* band = m_SurfaceBands.Find(GetChunkKey(coord.x, 0, coord.z)))
+        {
+            int bandDistance = WorldGenerator::GetSurfaceBandDistance(coord.y, *band);
+            priority += static_cast<float>(s_SurfaceBandPenalty * bandDistance * bandDistance);
+        }
+    }
+    return priority;
+}
+
+bool VoxelWorld::UpdatePrefetch(const float3& playerPosition, const float3& viewDirection, double frameTimeMs)
+{
+    // Smooth the per-frame velocity; a jump of several chunks in one frame is a teleport, not motion
+    float3 moved = playerPosition - m_PreviousPosition;
+    if (!m_HasPreviousPosition || length(moved) > 4.0f * CHUNK_X_SIZE)
+    {
+        m_PlayerVelocity = float3(0, 0, 0);
+    }
+    else if (frameTimeMs > 0.0)
+    {
+        float3 frameVelocity = moved / static_cast<float>(frameTimeMs / 1000.0);
+        m_PlayerVelocity = m_PlayerVelocity + (frameVelocity - m_PlayerVelocity) * s_VelocitySmoothing;
+    }
+    m_PreviousPosition = playerPosition;
+    m_HasPreviousPosition = true;
+    
+    float viewLength = length(viewDirection);
+    m_ViewDirection = viewLength > 0.0f ? viewDirection / viewLength : float3(0, 0, 0);
+    
+    // Predicted trajectory end in chunks, kept inside the streaming volume
+    float3 prefetchBlocks = m_PlayerVelocity * s_PrefetchLookaheadSeconds;
+    m_PrefetchOffset = float3(prefetchBlocks.x / CHUNK_X_SIZE, prefetchBlocks.y / CHUNK_Y_SIZE, prefetchBlocks.z / CHUNK_Z_SIZE);
+    float prefetchLength = length(m_PrefetchOffset);
+    float maxPrefetchLength = static_cast<float>(m_RenderDistance);
+    if (prefetchLength > maxPrefetchLength)
+        m_PrefetchOffset = m_PrefetchOffset * (maxPrefetchLength / prefetchLength);
+    
+    // Only a change of whole chunks in the trajectory, or of the rough heading, reorders the load queue
+    int prefetchKey[6] = {
+        static_cast<int>(std::round(m_PrefetchOffset.x)), static_cast<int>(std::round(m_PrefetchOffset.y)),
+        static_cast<int>(std::round(m_PrefetchOffset.z)), static_cast<int>(std::round(m_ViewDirection.x)),
+        static_cast<int>(std::round(m_ViewDirection.y)), static_cast<int>(std::round(m_ViewDirection.z))
+    };
+    if (!m_PredictivePrefetch)
+        std::fill(std::begin(prefetchKey), std::end(prefetchKey), 0);
+    if (std::equal(std::begin(prefetchKey), std::end(prefetchKey), std::begin(m_PrefetchKey)))
+        return false;
+    std::copy(std::begin(prefetchKey), std::end(prefetchKey), std::begin(m_PrefetchKey));
+    return true;
+}
+
+void VoxelWorld::CancelStaleJobs()
+{
+    // Jobs for chunks that left the load radius; one a worker has already started is dropped on arrival
+    m_StaleJobs.clear();
+    for (const ChunkCoordinate& coord : m_InFlightChunks)
+    {
+        if (!m_StreamingVolume.IsInsideLoadRadius(coord.x - m_LastPlayerChunkX, coord.y - m_LastPlayerChunkY, coord.z - m_LastPlayerChunkZ))
+            m_StaleJobs.push_back(coord);
+    }
+    if (m_StaleJobs.empty())
+        return;
+    
+    m_CancelledJobs.clear();
+    m_WorkerPool->Cancel(m_StaleJobs, m_CancelledJobs);
+    for (const ChunkCoordinate& coord : m_CancelledJobs)
+    {
+        m_InFlightChunks.Erase(coord);
+    }
+    m_CancelledJobCount += m_CancelledJobs.size();
 }
 
 Block VoxelWorld::GetBlock(int x, int y, int z) const
@@ -56,40 +268,494 @@ void VoxelWorld::SetBlock(int x, int y, int z, BlockType type)
     if (chunk != nullptr)
     {
         chunk->SetBlock(localX, localY, localZ, type);
+        MarkChunkDirty(chunkX, chunkY, chunkZ);
+        
+        // Border voxels also change the faces of the chunk next door
+        if (localX == 0) MarkChunkDirty(chunkX - 1, chunkY, chunkZ);
+        if (localX == CHUNK_X_SIZE - 1) MarkChunkDirty(chunkX + 1, chunkY, chunkZ);
+        if (localY == 0) MarkChunkDirty(chunkX, chunkY - 1, chunkZ);
+        if (localY == CHUNK_Y_SIZE - 1) MarkChunkDirty(chunkX, chunkY + 1, chunkZ);
+        if (localZ == 0) MarkChunkDirty(chunkX, chunkY, chunkZ - 1);
+        if (localZ == CHUNK_Z_SIZE - 1) MarkChunkDirty(chunkX, chunkY, chunkZ + 1);
     }
 }
 
 Chunk* VoxelWorld::GetChunk(int chunkX, int chunkY, int chunkZ) const
 {
-    int64_t key = GetChunkKey(chunkX, chunkY, chunkZ);
-    auto it = m_Chunks.find(key);
-    return (it != m_Chunks.end()) ? it->second.get() : nullptr;
+    return FindChunk(GetChunkKey(chunkX, chunkY, chunkZ));
+}
+
+Chunk* VoxelWorld::FindChunk(int64_t chunkKey) const
+{
+    const ChunkPtr* chunk = m_Chunks.Find(chunkKey);
+    return chunk != nullptr ? chunk->get() : nullptr;
 }
 
 void VoxelWorld::LoadChunk(int chunkX, int chunkY, int chunkZ)
 {
     int64_t key = GetChunkKey(chunkX, chunkY, chunkZ);
-    if (m_Chunks.find(key) == m_Chunks.end())
+    if (!m_Chunks.Contains(key))
     {
-        auto chunk = std::make_unique<Chunk>(chunkX, chunkY, chunkZ);
-        chunk->Generate();
-        chunk->BuildMesh(this);
+        ChunkPtr chunk = m_UnloadedCache.Take(ChunkCoordinate(chunkX, chunkY, chunkZ));
+        if (!chunk)
+        {
+            chunk = m_ChunkPool.Acquire(chunkX, chunkY, chunkZ);
+            std::shared_ptr<const TerrainColumn> column = m_ColumnCache.GetColumn(chunkX, chunkZ);
+            chunk->Generate(*column);
+            m_SurfaceBands[GetChunkKey(chunkX, 0, chunkZ)] = WorldGenerator::GetSurfaceBand(*column);
+        }
+        m_ChunkEvents.push_back(ChunkEvent{ChunkEventType::Loaded, ChunkCoordinate(chunkX, chunkY, chunkZ), chunk->GetMeshVersion()});
         m_Chunks[key] = std::move(chunk);
+        OnChunkArrived(ChunkCoordinate(chunkX, chunkY, chunkZ));
+    }
+}
+
+void VoxelWorld::OnChunkArrived(const ChunkCoordinate& coord)
+{
+    Chunk* chunk = GetChunk(coord.x, coord.y, coord.z);
+    bool meshStale = !chunk->IsMeshBuilt() || chunk->IsDirty();
+    
+    for (int face = 0; face < 6; ++face)
+    {
+        ChunkCoordinate neighborCoord(coord.x + s_NeighborOffsets[face][0], coord.y + s_NeighborOffsets[face][1], coord.z + s_NeighborOffsets[face][2]);
+        Chunk* neighbor = GetChunk(neighborCoord.x, neighborCoord.y, neighborCoord.z);
+        if (neighbor == nullptr)
+            continue;
+        
+        // Restored with a mesh built while this neighbor was missing
+        if (chunk->GetMissingNeighborMask() & (1u << face))
+            meshStale = true;
+        
+        // The neighbor was meshed while this side was empty: its border faces are now wrong.
+        // A mesh still on a worker was snapshotted before this chunk arrived, so it is wrong too;
+        // dirtying the neighbor gets a fresh snapshot and the in-flight result is dropped.
+        bool neighborStale = neighbor->IsMeshPending()
+            || (neighbor->IsMeshBuilt() && (neighbor->GetMissingNeighborMask() & (1u << GetOppositeFace(face))));
+        if (neighborStale)
+        {
+            MarkChunkDirty(neighborCoord.x, neighborCoord.y, neighborCoord.z);
+            m_BoundaryRemeshCount++;
+        }
+        else if (m_DirtyChunks.Contains(neighborCoord))
+        {
+            QueueMeshIfReady(neighborCoord);
+        }
+    }
+    
+    // A chunk restored from the unload cache keeps the mesh it left with when that is still right
+    if (meshStale)
+        MarkChunkDirty(coord.x, coord.y, coord.z);
+}
+
+bool VoxelWorld::AreNeighborsReady(const ChunkCoordinate& coord) const
+{
+    // A neighbor still to be streamed in would change this chunk's border faces;
+    // one outside the load radius will not arrive, so the chunk is meshed against air there
+    for (int face = 0; face < 6; ++face)
+    {
+        int neighborX = coord.x + s_NeighborOffsets[face][0];
+        int neighborY = coord.y + s_NeighborOffsets[face][1];
+        int neighborZ = coord.z + s_NeighborOffsets[face][2];
+        if (GetChunk(neighborX, neighborY, neighborZ) == nullptr &&
+            m_StreamingVolume.IsInsideLoadRadius(neighborX - m_LastPlayerChunkX, neighborY - m_LastPlayerChunkY, neighborZ - m_LastPlayerChunkZ))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VoxelWorld::QueueMeshIfReady(const ChunkCoordinate& coord)
+{
+    if (AreNeighborsReady(coord))
+        m_ReadyToMesh.Push(coord);
+}
+
+void VoxelWorld::QueueReadyNeighbors(const ChunkCoordinate& coord)
+{
+    for (int face = 0; face < 6; ++face)
+    {
+        ChunkCoordinate neighborCoord(coord.x + s_NeighborOffsets[face][0], coord.y + s_NeighborOffsets[face][1], coord.z + s_NeighborOffsets[face][2]);
+        if (m_DirtyChunks.Contains(neighborCoord))
+            QueueMeshIfReady(neighborCoord);
+    }
+}
+
+void VoxelWorld::MarkChunkDirty(int chunkX, int chunkY, int chunkZ)
+{
+    Chunk* chunk = GetChunk(chunkX, chunkY, chunkZ);
+    if (chunk == nullptr)
+    {
+        // A border edit next to a parked chunk: its cached mesh is rebuilt when it comes back
+        if (Chunk* cached = m_UnloadedCache.Find(ChunkCoordinate(chunkX, chunkY, chunkZ)))
+            cached->MarkDirty();
+        return;
+    }
+    
+    chunk->MarkDirty();
+    m_DirtyChunks.Insert(ChunkCoordinate(chunkX, chunkY, chunkZ));
+    QueueMeshIfReady(ChunkCoordinate(chunkX, chunkY, chunkZ));
+}
+
+void VoxelWorld::ProcessDirtyChunks()
+{
+    IntegrateMeshJobs();
+    
+    // Only chunks whose neighbors are ready sit in the ready queue; the rest stay in the
+    // dirty set until a neighbor arrives or leaves the load radius. As with generation, only a
+    // few jobs per worker are handed over at a time: the chunks still waiting keep collecting
+    // edits into one snapshot, and generation jobs are not crowded out of the workers.
+    const size_t maxInFlight = m_WorkerPool->GetWorkerCount() * 4;
+    while (!m_ReadyToMesh.Empty() && m_MeshJobsInFlight < maxInFlight && m_StreamingBudget.HasBudget(StreamingOp::Mesh))
+    {
+        ChunkCoordinate coord = m_ReadyToMesh.Pop();
+        
+        // Already meshed through an earlier entry
+        if (!m_DirtyChunks.Erase(coord))
+            continue;
+        
+        Chunk* chunk = GetChunk(coord.x, coord.y, coord.z);
+        if (chunk == nullptr || !chunk->IsDirty())
+            continue;
+        
+        // A neighbor moved into the load radius since this entry was queued
+        if (!AreNeighborsReady(coord))
+        {
+            m_DirtyChunks.Insert(coord);
+            continue;
+        }
+        
+        auto meshStart = StreamingBudget::Clock::now();
+        SubmitChunkMesh(coord, *chunk);
+        m_StreamingBudget.Record(StreamingOp::Mesh, meshStart);
+    }
+}
+
+void VoxelWorld::SubmitChunkMesh(const ChunkCoordinate& coord, Chunk& chunk)
+{
+    // The worker only reads the snapshot, so edits and arrivals after this point cannot race it;
+    // they dirty the chunk again and the next snapshot supersedes this one
+    ChunkMeshJobPtr job = m_WorkerPool->AcquireMeshJob();
+    job->Coord = coord;
+    job->Mode = m_MeshingMode;
+    FillChunkSnapshot(chunk, job->Snapshot);
+    job->MeshVersion = chunk.BeginMeshBuild();
+    
+    // An all-air chunk has nothing to mesh; skip the round trip
+    if (job->Snapshot.Contents == ChunkContents::UniformAir)
+    {
+        job->Vertices.clear();
+        job->BuildTimeMs = 0.0;
+        ApplyMeshJob(*job);
+        m_WorkerPool->ReleaseMeshJob(std::move(job));
+        return;
+    }
+    
+    m_WorkerPool->SubmitMesh(std::move(job), GetChunkPriority(coord));
+    m_MeshJobsInFlight++;
+}
+
+void VoxelWorld::IntegrateMeshJobs()
+{
+    PROFILE_SCOPE("VoxelWorld::IntegrateMeshJobs");
+    m_WorkerPool->CollectCompletedMeshes(m_CompletedMeshJobs);
+    
+    size_t jobIndex = 0;
+    for (; jobIndex < m_CompletedMeshJobs.size() && m_StreamingBudget.HasBudget(StreamingOp::Mesh); ++jobIndex)
+    {
+        auto applyStart = StreamingBudget::Clock::now();
+        ChunkMeshJobPtr& job = m_CompletedMeshJobs[jobIndex];
+        
+        // Stale results (chunk unloaded, or snapshotted again since) are dropped without touching the budget
+        if (ApplyMeshJob(*job))
+            m_StreamingBudget.Record(StreamingOp::Mesh, applyStart);
+        m_WorkerPool->ReleaseMeshJob(std::move(job));
+        m_MeshJobsInFlight--;
+    }
+    m_CompletedMeshJobs.erase(m_CompletedMeshJobs.begin(), m_CompletedMeshJobs.begin() + jobIndex);
+}
+
+bool VoxelWorld::ApplyMeshJob(const ChunkMeshJob& job)
+{
+    Chunk* chunk = GetChunk(job.Coord.x, job.Coord.y, job.Coord.z);
+    if (chunk == nullptr)
+        return false;
+    
+    if (!chunk->ApplyMesh(job.Vertices, job.Snapshot.MissingNeighborMask, job.MeshVersion, m_MeshBuffers))
+        return false;
+    
+    m_ChunkEvents.push_back(ChunkEvent{ChunkEventType::Remeshed, job.Coord, chunk->GetMeshVersion()});
+    RecordMeshBuild(job.Mode, job.BuildTimeMs, *chunk);
+    return true;
+}
+
+void VoxelWorld::DrainChunkEvents(std::vector<ChunkEvent>& outEvents)
+{
+    outEvents.insert(outEvents.end(), m_ChunkEvents.begin(), m_ChunkEvents.end());
+    m_ChunkEvents.clear();
+}
+
+void VoxelWorld::FillChunkSnapshot(const Chunk& chunk, ChunkSnapshot& snapshot) const
+{
+    constexpr int N = CHUNK_X_SIZE;
+    chunk.FillSnapshot(snapshot);
+    snapshot.MissingNeighborMask = 0;
+    
+    // Copy the layer of each face neighbor that touches this chunk into the padding.
+    // Missing neighbors read as air, and the side is remembered so it can be fixed up when the neighbor loads.
+    for (int face = 0; face < 6; ++face)
+    {
+        const int* offset = s_NeighborOffsets[face];
+        const Chunk* neighbor = GetChunk(chunk.GetChunkX() + offset[0], chunk.GetChunkY() + offset[1], chunk.GetChunkZ() + offset[2]);
+        if (neighbor == nullptr)
+            snapshot.MissingNeighborMask |= static_cast<uint8_t>(1u << face);
+        
+        // Snapshot coordinates of the padding layer, and the neighbor's coordinates of the same voxels
+        const int normalAxis = offset[0] != 0 ? 0 : (offset[1] != 0 ? 1 : 2);
+        const int uAxis = normalAxis == 0 ? 1 : 0;
+        const int vAxis = normalAxis == 2 ? 1 : 2;
+        int pos[3];
+        int neighborPos[3];
+        pos[normalAxis] = offset[normalAxis] > 0 ? N : -1;
+        neighborPos[normalAxis] = offset[normalAxis] > 0 ? 0 : N - 1;
+        
+        for (int v = 0; v < N; ++v)
+        {
+            pos[vAxis] = neighborPos[vAxis] = v;
+            for (int u = 0; u < N; ++u)
+            {
+                pos[uAxis] = neighborPos[uAxis] = u;
+                snapshot.Blocks[ChunkSnapshot::Index(pos[0], pos[1], pos[2])] = neighbor != nullptr ?
+                    neighbor->GetBlockType(neighborPos[0], neighborPos[1], neighborPos[2]) : BlockType::Air;
+            }
+        }
+    }
+}
+
+void VoxelWorld::RecordMeshBuild(MeshingMode mode, double buildTimeMs, const Chunk& chunk)
+{
+    // Uniform chunks skip the mesher entirely, so only count real mesh builds
+    if (chunk.IsUniform() && chunk.GetVertexCount() == 0)
+        return;
+    
+    MeshingStats& stats = m_MeshingStats[static_cast<int>(mode)];
+    stats.LastBuildTimeMs = buildTimeMs;
+    stats.TotalBuildTimeMs += buildTimeMs;
+    stats.MeshesBuilt++;
+    stats.VerticesEmitted += chunk.GetVertexCount();
+    stats.IndicesEmitted += chunk.GetIndexCount();
+}
+
+void VoxelWorld::SetMeshingMode(MeshingMode mode)
+{
+    if (mode == m_MeshingMode)
+        return;
+    
+    // Remesh everything so the two modes can be compared on the same world
+    m_MeshingMode = mode;
+    for (auto& [key, chunk] : m_Chunks)
+    {
+        MarkChunkDirty(chunk->GetChunkX(), chunk->GetChunkY(), chunk->GetChunkZ());
+    }
+}
+
+void VoxelWorld::ResetMeshingStats()
+{
+    for (MeshingStats& stats : m_MeshingStats)
+    {
+        stats = MeshingStats{};
+    }
+}
+
+void VoxelWorld::CompareMeshingModes(MeshingMode reference, MeshingMode candidate)
+{
+    // The loaded world is the corpus: both modes mesh the same snapshots, the chunks' own meshes are untouched
+    MesherComparison& result = m_MesherComparison;
+    result = MesherComparison{};
+    std::vector<ChunkVertex> referenceVertices;
+    std::vector<ChunkVertex> candidateVertices;
+    
+    for (const auto& [key, chunk] : m_Chunks)
+    {
+        FillChunkSnapshot(*chunk, m_MeshSnapshot);
+        
+        auto startTime = std::chrono::high_resolution_clock::now();
+        ChunkMesher::BuildMesh(m_MeshSnapshot, reference, referenceVertices);
+        auto midTime = std::chrono::high_resolution_clock::now();
+        ChunkMesher::BuildMesh(m_MeshSnapshot, candidate, candidateVertices);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        
+        result.ReferenceTimeMs += std::chrono::duration<double, std::milli>(midTime - startTime).count();
+        result.CandidateTimeMs += std::chrono::duration<double, std::milli>(endTime - midTime).count();
+        result.ChunksCompared++;
+        
+        bool identical = referenceVertices.size() == candidateVertices.size() &&
+            std::equal(referenceVertices.begin(), referenceVertices.end(), candidateVertices.begin(),
+                       [](const ChunkVertex& a, const ChunkVertex& b) { return a.PositionAndFace == b.PositionAndFace && a.Attributes == b.Attributes; });
+        if (!identical)
+            result.Mismatches++;
+    }
+}
+
+void VoxelWorld::BenchmarkGeneration()
+{
+    // Corpus: an 8x8 block of columns around the player, from below the stone line to above the hills
+    const int centerX = m_LastPlayerChunkX == INT_MAX ? 0 : m_LastPlayerChunkX;
+    const int centerZ = m_LastPlayerChunkZ == INT_MAX ? 0 : m_LastPlayerChunkZ;
+    const WorldGenerator simdGenerator(m_Generator.GetSeed(), NoiseKernel::Simd);
+    const WorldGenerator scalarGenerator(m_Generator.GetSeed(), NoiseKernel::Scalar);
+    
+    GenerationBenchmark& result = m_GenerationBenchmark;
+    result = GenerationBenchmark{};
+    double simdTimeMs = 0.0;
+    double scalarTimeMs = 0.0;
+    std::array<BlockType, CHUNK_VOLUME> simdBlocks;
+    std::array<BlockType, CHUNK_VOLUME> scalarBlocks;
+    
+    // Each kernel evaluates a column once and generates its whole stack from it, as the cache does
+    TerrainColumn simdColumn;
+    TerrainColumn scalarColumn;
+    for (int chunkX = centerX - 4; chunkX < centerX + 4; ++chunkX)
+    {
+        for (int chunkZ = centerZ - 4; chunkZ < centerZ + 4; ++chunkZ)
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            simdGenerator.GenerateColumn(chunkX, chunkZ, simdColumn);
+            auto midTime = std::chrono::high_resolution_clock::now();
+            scalarGenerator.GenerateColumn(chunkX, chunkZ, scalarColumn);
+            auto endTime = std::chrono::high_resolution_clock::now();
+            simdTimeMs += std::chrono::duration<double, std::milli>(midTime - startTime).count();
+            scalarTimeMs += std::chrono::duration<double, std::milli>(endTime - midTime).count();
+            
+            for (int chunkY = -2; chunkY <= 4; ++chunkY)
+            {
+                Chunk simdChunk(chunkX, chunkY, chunkZ);
+                Chunk scalarChunk(chunkX, chunkY, chunkZ);
+                
+                startTime = std::chrono::high_resolution_clock::now();
+                simdChunk.Generate(simdColumn);
+                midTime = std::chrono::high_resolution_clock::now();
+                scalarChunk.Generate(scalarColumn);
+                endTime = std::chrono::high_resolution_clock::now();
+                simdTimeMs += std::chrono::duration<double, std::milli>(midTime - startTime).count();
+                scalarTimeMs += std::chrono::duration<double, std::milli>(endTime - midTime).count();
+                
+                simdChunk.DecodeBlocks(simdBlocks.data());
+                scalarChunk.DecodeBlocks(scalarBlocks.data());
+                if (simdChunk.GetContents() != scalarChunk.GetContents() || simdBlocks != scalarBlocks)
+                    result.Mismatches++;
+                result.ChunksGenerated++;
+            }
+        }
+    }
+    
+    result.SimdChunksPerSecond = simdTimeMs > 0.0 ? result.ChunksGenerated * 1000.0 / simdTimeMs : 0.0;
+    result.ScalarChunksPerSecond = scalarTimeMs > 0.0 ? result.ChunksGenerated * 1000.0 / scalarTimeMs : 0.0;
+}
+
+ChunkAllocationStats VoxelWorld::GetAllocationStats() const
+{
+    ChunkAllocationStats stats;
+    stats.Chunks = m_ChunkPool.GetStats();
+    stats.Voxels = BlockSlab::Get().GetStats();
+    stats.MeshBuffers = m_MeshBuffers.GetStats();
+    stats.HeapAllocationsLastFrame = m_HeapAllocationsLastFrame;
+    return stats;
+}
+
+void VoxelWorld::BenchmarkChunkLookup()
+{
+    // Corpus: every loaded chunk and its six neighbors, the lookups meshing and border edits make,
+    // in shuffled order so neither structure benefits from walking its own layout
+    std::unordered_map<int64_t, Chunk*> referenceMap;
+    std::vector<int64_t> keys;
+    referenceMap.reserve(m_Chunks.Size());
+    keys.reserve(m_Chunks.Size() * 7);
+    for (const auto& [key, chunk] : m_Chunks)
+    {
+        referenceMap.emplace(key, chunk.get());
+        keys.push_back(key);
+        for (int face = 0; face < 6; ++face)
+        {
+            keys.push_back(GetChunkKey(chunk->GetChunkX() + s_NeighborOffsets[face][0],
+                                       chunk->GetChunkY() + s_NeighborOffsets[face][1],
+                                       chunk->GetChunkZ() + s_NeighborOffsets[face][2]));
+        }
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(12345));
+    
+    ChunkLookupBenchmark& result = m_ChunkLookupBenchmark;
+    result = ChunkLookupBenchmark{};
+    for (int64_t key : keys)
+    {
+        const ChunkPtr* chunk = m_Chunks.Find(key);
+        auto it = referenceMap.find(key);
+        Chunk* expected = it != referenceMap.end() ? it->second : nullptr;
+        if ((chunk != nullptr ? chunk->get() : nullptr) != expected)
+            result.Mismatches++;
+        if (expected != nullptr)
+            result.Hits++;
+    }
+    
+    // Both walks dereference the chunk they find, as GetBlock does
+    const int passes = 16;
+    size_t indexMeshed = 0;
+    size_t mapMeshed = 0;
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        for (int64_t key : keys)
+        {
+            const ChunkPtr* chunk = m_Chunks.Find(key);
+            if (chunk != nullptr && (*chunk)->IsMeshBuilt())
+                indexMeshed++;
+        }
+    }
+    auto midTime = std::chrono::high_resolution_clock::now();
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        for (int64_t key : keys)
+        {
+            auto it = referenceMap.find(key);
+            if (it != referenceMap.end() && it->second->IsMeshBuilt())
+                mapMeshed++;
+        }
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    if (indexMeshed != mapMeshed)
+        result.Mismatches++;
+    
+    result.Lookups = keys.size();
+    if (!keys.empty())
+    {
+        result.IndexNsPerLookup = std::chrono::duration<double, std::nano>(midTime - startTime).count() / (keys.size() * passes);
+        result.MapNsPerLookup = std::chrono::duration<double, std::nano>(endTime - midTime).count() / (keys.size() * passes);
     }
 }
 
 void VoxelWorld::UnloadChunk(int chunkX, int chunkY, int chunkZ)
 {
     int64_t key = GetChunkKey(chunkX, chunkY, chunkZ);
-    m_Chunks.erase(key);
+    ChunkPtr* chunk = m_Chunks.Find(key);
+    if (chunk == nullptr)
+        return;
+    
+    // Parked with its blocks and mesh in case the player turns back; a mesh still on a worker
+    // is dropped when it returns, so the chunk is remeshed if it is restored
+    if ((*chunk)->IsMeshPending())
+        (*chunk)->MarkDirty();
+    m_UnloadedCache.Insert(std::move(*chunk));
+    m_Chunks.Erase(key);
+    
+    m_DirtyChunks.Erase(ChunkCoordinate(chunkX, chunkY, chunkZ));
+    m_ChunkEvents.push_back(ChunkEvent{ChunkEventType::Unloaded, ChunkCoordinate(chunkX, chunkY, chunkZ), 0});
+    
+    // Neighbors are not remeshed: the chunk left the unload radius, so its border faces face away from the player
 }
 
 int64_t VoxelWorld::GetChunkKey(int chunkX, int chunkY, int chunkZ) const
 {
-    // Create a 64-bit key from 3D coordinates (21 bits each, with some overflow protection)
-    return (static_cast<int64_t>(chunkX & 0x1FFFFF) << 42) | 
-           (static_cast<int64_t>(chunkY & 0x1FFFFF) << 21) | 
-           (static_cast<int64_t>(chunkZ & 0x1FFFFF));
+    return MakeChunkKey(chunkX, chunkY, chunkZ);
 }
 
 void VoxelWorld::GetChunkCoordinates(int worldX, int worldY, int worldZ, int& chunkX, int& chunkY, int& chunkZ, int& localX, int& localY, int& localZ) const
@@ -122,6 +788,7 @@ void VoxelWorld::GetChunkCoordinates(int worldX, int worldY, int worldZ, int& ch
 
 void VoxelWorld::QueueChunksAroundPlayer(const float3& playerPosition)
 {
+    PROFILE_SCOPE("VoxelWorld::QueueChunksAroundPlayer");
     int playerChunkX = static_cast<int>(std::floor(playerPosition.x / CHUNK_X_SIZE));
     int playerChunkY = static_cast<int>(std::floor(playerPosition.y / CHUNK_Y_SIZE));
     int playerChunkZ = static_cast<int>(std::floor(playerPosition.z / CHUNK_Z_SIZE));
@@ -129,81 +796,89 @@ void VoxelWorld::QueueChunksAroundPlayer(const float3& playerPosition)
     // Clear existing queue since we have a new target position
     ClearChunkQueue();
     
-    // Create a list of chunks to generate, sorted by distance from player
-    std::vector<std::pair<float, ChunkCoordinate>> chunksToQueue;
-    
-    // Calculate all chunks within render distance
-    for (int x = playerChunkX - m_RenderDistance; x <= playerChunkX + m_RenderDistance; ++x)
-    {
-        for (int y = playerChunkY - m_RenderDistance; y <= playerChunkY + m_RenderDistance; ++y)
-        {
-            for (int z = playerChunkZ - m_RenderDistance; z <= playerChunkZ + m_RenderDistance; ++z)
-            {
-                // Check if chunk is within spherical render distance
-                int dx = x - playerChunkX;
-                int dy = y - playerChunkY;
-                int dz = z - playerChunkZ;
-                float distanceSquared = static_cast<float>(dx * dx + dy * dy + dz * dz);
-                
-                if (distanceSquared <= m_RenderDistance * m_RenderDistance)
-                {
-                    // Only queue if chunk doesn't exist yet
-                    if (GetChunk(x, y, z) == nullptr)
-                    {
-                        chunksToQueue.emplace_back(distanceSquared, ChunkCoordinate(x, y, z));
-                    }
-                }
-            }
-        }
-    }
-    
-    // Sort chunks by distance (closest first)
-    std::sort(chunksToQueue.begin(), chunksToQueue.end());
-    
-    // Add sorted chunks to the generation queue
-    for (const auto& pair : chunksToQueue)
+    // The volume's offsets are already sorted nearest first
+    for (const ChunkOffset& offset : m_StreamingVolume.GetLoadOffsets())
     {
-        const ChunkCoordinate& coord = pair.second;
-        if (m_QueuedChunks.find(coord) == m_QueuedChunks.end())
+        ChunkCoordinate coord(playerChunkX + offset.x, playerChunkY + offset.y, playerChunkZ + offset.z);
+        
+        // Only queue if chunk doesn't exist yet and isn't already on a worker
+        if (GetChunk(coord.x, coord.y, coord.z) == nullptr && !m_InFlightChunks.Contains(coord))
         {
-            m_ChunkGenerationQueue.push(coord);
-            m_QueuedChunks.insert(coord);
+            m_LoadQueue.Push(coord, GetChunkPriority(coord));
         }
     }
 }
 
-void VoxelWorld::ProcessChunkQueue(int maxChunksPerFrame)
+void VoxelWorld::ProcessChunkQueue()
 {
-    int chunksProcessed = 0;
+    PROFILE_SCOPE("VoxelWorld::ProcessChunkQueue");
+    // Integrate chunks the workers have generated; they are meshed once their neighbors are in
+    m_WorkerPool->CollectCompleted(m_CompletedJobs);
     
-    while (!m_ChunkGenerationQueue.empty() && chunksProcessed < maxChunksPerFrame)
+    size_t resultIndex = 0;
+    for (; resultIndex < m_CompletedJobs.size() && m_StreamingBudget.HasBudget(StreamingOp::Integrate); ++resultIndex)
     {
-        ChunkCoordinate coord = m_ChunkGenerationQueue.front();
-        m_ChunkGenerationQueue.pop();
-        m_QueuedChunks.erase(coord);
+        auto integrateStart = StreamingBudget::Clock::now();
+        ChunkJobResult& result = m_CompletedJobs[resultIndex];
+        Chunk* chunk = result.ChunkData.get();
+        m_GenerationStats.ChunksGenerated++;
+        m_GenerationStats.TotalGenerationTimeMs += result.GenerationTimeMs;
+        ChunkCoordinate coord(chunk->GetChunkX(), chunk->GetChunkY(), chunk->GetChunkZ());
+        m_InFlightChunks.Erase(coord);
+        m_SurfaceBands[GetChunkKey(coord.x, 0, coord.z)] = result.Band;
         
+        // Drop chunks the player has already left behind
+        if (GetChunk(coord.x, coord.y, coord.z) != nullptr || IsBeyondDeletionDistance(coord))
+            continue;
+        
+        m_ChunkEvents.push_back(ChunkEvent{ChunkEventType::Loaded, coord, chunk->GetMeshVersion()});
+        m_Chunks[GetChunkKey(coord.x, coord.y, coord.z)] = std::move(result.ChunkData);
+        OnChunkArrived(coord);
+        m_StreamingBudget.Record(StreamingOp::Integrate, integrateStart);
+    }
+    m_CompletedJobs.erase(m_CompletedJobs.begin(), m_CompletedJobs.begin() + resultIndex);
+    
+    // Keep the workers fed from the load queue. Only a few jobs per worker are
+    // handed over at a time so chunks entering the volume near the player go first.
+    const size_t maxInFlight = m_WorkerPool->GetWorkerCount() * 4;
+    auto currentPriority = [this](const ChunkCoordinate& coord) { return GetChunkPriority(coord); };
+    ChunkCoordinate coord(0, 0, 0);
+    while (m_InFlightChunks.Size() < maxInFlight && m_LoadQueue.Pop(coord, currentPriority))
+    {
         // Double-check the chunk still doesn't exist
-        if (GetChunk(coord.x, coord.y, coord.z) == nullptr)
+        if (GetChunk(coord.x, coord.y, coord.z) != nullptr || m_InFlightChunks.Contains(coord))
+            continue;
+        
+        // Recently unloaded chunks come back from the cache without generation or meshing;
+        // restoring counts as integration, so it waits for next frame once the budget is spent
+        if (!m_StreamingBudget.HasBudget(StreamingOp::Integrate) && m_UnloadedCache.Find(coord) != nullptr)
+        {
+            m_LoadQueue.Push(coord, GetChunkPriority(coord));
+            break;
+        }
+        auto restoreStart = StreamingBudget::Clock::now();
+        if (ChunkPtr cached = m_UnloadedCache.Take(coord))
         {
-            LoadChunk(coord.x, coord.y, coord.z);
-            chunksProcessed++;
+            m_ChunkEvents.push_back(ChunkEvent{ChunkEventType::Loaded, coord, cached->GetMeshVersion()});
+            m_Chunks[GetChunkKey(coord.x, coord.y, coord.z)] = std::move(cached);
+            OnChunkArrived(coord);
+            m_StreamingBudget.Record(StreamingOp::Integrate, restoreStart);
+            continue;
         }
+        
+        m_WorkerPool->Submit(coord.x, coord.y, coord.z, GetChunkPriority(coord));
+        m_InFlightChunks.Insert(coord);
     }
 }
 
 void VoxelWorld::ClearChunkQueue()
 {
-    // Clear the queue
-    std::queue<ChunkCoordinate> empty;
-    m_ChunkGenerationQueue.swap(empty);
-    
-    // Clear the set
-    m_QueuedChunks.clear();
+    m_LoadQueue.Clear();
 }
 
 bool VoxelWorld::IsChunkQueued(int chunkX, int chunkY, int chunkZ) const
 {
-    return m_QueuedChunks.find(ChunkCoordinate(chunkX, chunkY, chunkZ)) != m_QueuedChunks.end();
+    return m_LoadQueue.Contains(ChunkCoordinate(chunkX, chunkY, chunkZ));
 }
 
 void VoxelWorld::QueueChunksForDeletion(const float3& playerPosition)
@@ -234,8 +909,7 @@ void VoxelWorld::QueueChunksForDeletion(const float3& playerPosition)
         float distanceSquared = static_cast<float>(dx * dx + dy * dy + dz * dz);
         
         // Queue for deletion if outside render distance (with buffer)
-        float deletionDistanceSquared = (m_RenderDistance + 2) * (m_RenderDistance + 2);
-        if (distanceSquared > deletionDistanceSquared)
+        if (!m_StreamingVolume.IsInsideUnloadRadius(dx, dy, dz))
         {
             chunksToDelete.emplace_back(distanceSquared, ChunkCoordinate(chunkX, chunkY, chunkZ));
         }
@@ -248,40 +922,30 @@ void VoxelWorld::QueueChunksForDeletion(const float3& playerPosition)
     for (const auto& pair : chunksToDelete)
     {
         const ChunkCoordinate& coord = pair.second;
-        if (m_QueuedForDeletion.find(coord) == m_QueuedForDeletion.end())
+        if (m_QueuedForDeletion.Insert(coord))
         {
-            m_ChunkDeletionQueue.push(coord);
-            m_QueuedForDeletion.insert(coord);
+            m_ChunkDeletionQueue.Push(coord);
         }
     }
 }
 
-void VoxelWorld::ProcessDeletionQueue(int maxChunksPerFrame)
+void VoxelWorld::ProcessDeletionQueue()
 {
-    int chunksProcessed = 0;
-    
-    while (!m_ChunkDeletionQueue.empty() && chunksProcessed < maxChunksPerFrame)
+    while (!m_ChunkDeletionQueue.Empty() && m_StreamingBudget.HasBudget(StreamingOp::Unload))
     {
-        ChunkCoordinate coord = m_ChunkDeletionQueue.front();
-        m_ChunkDeletionQueue.pop();
-        m_QueuedForDeletion.erase(coord);
+        ChunkCoordinate coord = m_ChunkDeletionQueue.Pop();
+        m_QueuedForDeletion.Erase(coord);
         
         // Double-check the chunk still exists and is still outside render distance
         Chunk* chunk = GetChunk(coord.x, coord.y, coord.z);
         if (chunk != nullptr)
         {
-            // Calculate current distance from player
-            int dx = coord.x - m_LastPlayerChunkX;
-            int dy = coord.y - m_LastPlayerChunkY;
-            int dz = coord.z - m_LastPlayerChunkZ;
-            float distanceSquared = static_cast<float>(dx * dx + dy * dy + dz * dz);
-            
             // Only delete if still outside render distance
-            float deletionDistanceSquared = (m_RenderDistance + 2) * (m_RenderDistance + 2);
-            if (distanceSquared > deletionDistanceSquared)
+            if (IsBeyondDeletionDistance(coord))
             {
+                auto unloadStart = StreamingBudget::Clock::now();
                 UnloadChunk(coord.x, coord.y, coord.z);
-                chunksProcessed++;
+                m_StreamingBudget.Record(StreamingOp::Unload, unloadStart);
             }
         }
     }
@@ -290,14 +954,34 @@ void VoxelWorld::ProcessDeletionQueue(int maxChunksPerFrame)
 void VoxelWorld::ClearDeletionQueue()
 {
     // Clear the queue
-    std::queue<ChunkCoordinate> empty;
-    m_ChunkDeletionQueue.swap(empty);
+    m_ChunkDeletionQueue.Clear();
     
     // Clear the set
-    m_QueuedForDeletion.clear();
+    m_QueuedForDeletion.Clear();
+}
+
+void VoxelWorld::PruneSurfaceBands()
+{
+    // Columns that left the unload radius; a chunk generated there again brings its band back
+    m_StaleSurfaceBands.clear();
+    for (const auto& [key, band] : m_SurfaceBands)
+    {
+        ChunkCoordinate column = ChunkKeyToCoordinate(key);
+        if (IsBeyondDeletionDistance(ChunkCoordinate(column.x, m_LastPlayerChunkY, column.z)))
+            m_StaleSurfaceBands.push_back(key);
+    }
+    for (int64_t key : m_StaleSurfaceBands)
+    {
+        m_SurfaceBands.Erase(key);
+    }
+}
+
+bool VoxelWorld::IsBeyondDeletionDistance(const ChunkCoordinate& coord) const
+{
+    return !m_StreamingVolume.IsInsideUnloadRadius(coord.x - m_LastPlayerChunkX, coord.y - m_LastPlayerChunkY, coord.z - m_LastPlayerChunkZ);
 }
 
 bool VoxelWorld::IsChunkQueuedForDeletion(int chunkX, int chunkY, int chunkZ) const
 {
-    return m_QueuedForDeletion.find(ChunkCoordinate(chunkX, chunkY, chunkZ)) != m_QueuedForDeletion.end();
+    return m_QueuedForDeletion.Contains(ChunkCoordinate(chunkX, chunkY, chunkZ));
 }
\ No newline at end of file
@@ -1,48 +1,108 @@
 #pragma once
 
 #include "Chunk.h"
+#include "ChunkMesher.h"
+#include "ChunkCoordinate.h"
+#include "ChunkMap.h"
+#include "ChunkPool.h"
+#include "ChunkPriorityQueue.h"
+#include "ChunkQueue.h"
+#include "MeshBufferPool.h"
+#include "BlockSlab.h"
+#include "ChunkWorkerPool.h"
+#include "StreamingBudget.h"
+#include "StreamingVolume.h"
+#include "TerrainColumnCache.h"
+#include "UnloadedChunkCache.h"
 #include <unordered_map>
 #include <memory>
-#include <queue>
 #include <vector>
-#include <unordered_set>
+#include <climits>
 
-struct ChunkCoordinate
+// Accumulated mesh build statistics for one meshing mode
+struct MeshingStats
 {
-    int x, y, z;
-    
-    ChunkCoordinate(int x, int y, int z) : x(x), y(y), z(z) {}
-    
-    bool operator==(const ChunkCoordinate& other) const
-    {
-        return x == other.x && y == other.y && z == other.z;
-    }
-    
-    bool operator<(const ChunkCoordinate& other) const
-    {
-        if (x != other.x) return x < other.x;
-        if (y != other.y) return y < other.y;
-        return z < other.z;
-    }
+    size_t MeshesBuilt = 0;
+    size_t VerticesEmitted = 0;
+    size_t IndicesEmitted = 0;
+    double TotalBuildTimeMs = 0.0;
+    double LastBuildTimeMs = 0.0;
+};
+
+// Result of meshing every loaded chunk with two meshing modes and comparing the vertex streams
+struct MesherComparison
+{
+    size_t ChunksCompared = 0;
+    size_t Mismatches = 0;
+    double ReferenceTimeMs = 0.0;
+    double CandidateTimeMs = 0.0;
+};
+
+// Heap traffic of streaming. HeapAllocationsLastFrame counts every allocation the last Update made
+// on the main thread and on the workers, through the global allocation counter; once streaming
+// reaches a steady state, chunks, voxel storage, mesh buffers and bookkeeping are all recycled and
+// it stays at zero. The pool and slab stats break down where chunk memory comes from.
+struct ChunkAllocationStats
+{
+    ChunkPoolStats Chunks;
+    BlockSlabStats Voxels;
+    MeshBufferPoolStats MeshBuffers;
+    size_t HeapAllocationsLastFrame = 0;
+};
+
+// Chunk generation cost as measured on the worker threads
+struct GenerationStats
+{
+    size_t ChunksGenerated = 0;
+    double TotalGenerationTimeMs = 0.0;
+};
+
+// Single-threaded generation throughput of the vectorized and scalar noise kernels on the
+// same chunks, which must come out block-for-block identical
+struct GenerationBenchmark
+{
+    size_t ChunksGenerated = 0;
+    size_t Mismatches = 0;
+    double SimdChunksPerSecond = 0.0;
+    double ScalarChunksPerSecond = 0.0;
+};
+
+// Chunk lookup latency of the chunk index against a node-based map holding the same chunks
+struct ChunkLookupBenchmark
+{
+    size_t Lookups = 0;
+    size_t Hits = 0;
+    size_t Mismatches = 0;
+    double IndexNsPerLookup = 0.0;
+    double MapNsPerLookup = 0.0;
 };
 
-// Hash function for ChunkCoordinate to use in unordered_set
-struct ChunkCoordinateHash
+// Chunk lifecycle notifications for the renderer, drained once per frame.
+// Loaded/Remeshed carry the mesh version they announce; a consumer that sees an older
+// version than the chunk's current one can skip the upload, a newer event is on its way.
+enum class ChunkEventType : uint8_t
 {
-    std::size_t operator()(const ChunkCoordinate& coord) const
-    {
-        return std::hash<int>()(coord.x) ^ (std::hash<int>()(coord.y) << 1) ^ (std::hash<int>()(coord.z) << 2);
-    }
+    Loaded = 0,
+    Remeshed,
+    Unloaded
+};
+
+struct ChunkEvent
+{
+    ChunkEventType Type;
+    ChunkCoordinate Coord;
+    uint32_t MeshVersion;
 };
 
 class VoxelWorld
 {
 public:
-    VoxelWorld();
+    explicit VoxelWorld(uint64_t seed = WorldGenerator::DefaultSeed);
     ~VoxelWorld() = default;
     
-    // World management
-    void Update(const float3& playerPosition);
+    // World management; frameTimeMs is the previous frame's duration, which steers the streaming budget
+    // and the velocity estimate behind the predictive prefetch
+    void Update(const float3& playerPosition, const float3& viewDirection, double frameTimeMs);
     void Render();
     
     // Block access
@@ -51,42 +111,133 @@ public:
     
     // Chunk management
     Chunk* GetChunk(int chunkX, int chunkY, int chunkZ) const;
+    Chunk* FindChunk(int64_t chunkKey) const;    // Key from MakeChunkKey
     void LoadChunk(int chunkX, int chunkY, int chunkZ);
     void UnloadChunk(int chunkX, int chunkY, int chunkZ);
     
     // Access to loaded chunks for rendering
-    const std::unordered_map<int64_t, std::unique_ptr<Chunk>>& GetLoadedChunks() const { return m_Chunks; }
-    size_t GetChunkCount() const { return m_Chunks.size(); }
+    const ChunkMap<ChunkPtr>& GetLoadedChunks() const { return m_Chunks; }
+    size_t GetChunkCount() const { return m_Chunks.Size(); }
+    ChunkAllocationStats GetAllocationStats() const;
+    void BenchmarkChunkLookup();
+    const ChunkLookupBenchmark& GetChunkLookupBenchmark() const { return m_ChunkLookupBenchmark; }
     
-    // Chunk generation queue system
-    void ProcessChunkQueue(int maxChunksPerFrame = 2);
+    // Chunk generation queue system (generation runs on worker threads; finished chunks are
+    // integrated on the main thread as far as the streaming budget allows)
+    void ProcessChunkQueue();
     void QueueChunksAroundPlayer(const float3& playerPosition);
     void ClearChunkQueue();
     bool IsChunkQueued(int chunkX, int chunkY, int chunkZ) const;
-    size_t GetQueueSize() const { return m_ChunkGenerationQueue.size(); }
+    size_t GetQueueSize() const { return m_LoadQueue.Size(); }
+    size_t GetInFlightCount() const { return m_InFlightChunks.Size(); }
+    size_t GetCompletedCount() const { return m_CompletedJobs.size(); }
+    size_t GetCancelledJobCount() const { return m_CancelledJobCount; }
+    size_t GetWorkerCount() const { return m_WorkerPool->GetWorkerCount(); }
+    
+    // Terrain generation
+    const WorldGenerator& GetGenerator() const { return m_Generator; }
+    int GetSurfaceHeight(int worldX, int worldZ) const { return m_Generator.GetSurfaceHeight(worldX, worldZ); }
+    const GenerationStats& GetGenerationStats() const { return m_GenerationStats; }
+    TerrainColumnCacheStats GetColumnCacheStats() const { return m_ColumnCache.GetStats(); }
+    void BenchmarkGeneration();
+    const GenerationBenchmark& GetGenerationBenchmark() const { return m_GenerationBenchmark; }
+    
+    // Unloaded chunks are parked in a memory-capped cache and restored from it on return
+    UnloadedChunkCacheStats GetUnloadedCacheStats() const { return m_UnloadedCache.GetStats(); }
+    void SetUnloadedCacheBudget(size_t memoryBudget) { m_UnloadedCache.SetMemoryBudget(memoryBudget); }
+    size_t GetUnloadedCacheBudget() const { return m_UnloadedCache.GetMemoryBudget(); }
     
     // Chunk deletion queue system
-    void ProcessDeletionQueue(int maxChunksPerFrame = 1);
+    void ProcessDeletionQueue();
     void QueueChunksForDeletion(const float3& playerPosition);
     void ClearDeletionQueue();
     bool IsChunkQueuedForDeletion(int chunkX, int chunkY, int chunkZ) const;
-    size_t GetDeletionQueueSize() const { return m_ChunkDeletionQueue.size(); }
+    size_t GetDeletionQueueSize() const { return m_ChunkDeletionQueue.Size(); }
+    
+    // Chunk lifecycle: dirty chunks are snapshotted a few per frame and meshed on the workers,
+    // and every load, remesh and unload is reported as an event
+    void MarkChunkDirty(int chunkX, int chunkY, int chunkZ);
+    void ProcessDirtyChunks();
+    size_t GetDirtyChunkCount() const { return m_DirtyChunks.Size(); }
+    size_t GetReadyToMeshCount() const { return m_ReadyToMesh.Size(); }
+    size_t GetMeshingCount() const { return m_MeshJobsInFlight; }   // On the workers or waiting to be applied
+    size_t GetBoundaryRemeshCount() const { return m_BoundaryRemeshCount; }
+    void DrainChunkEvents(std::vector<ChunkEvent>& outEvents);
+    
+    // Main-thread time budget shared by integration, meshing, unloads and the renderer's uploads
+    StreamingBudget& GetStreamingBudget() { return m_StreamingBudget; }
+    const StreamingBudget& GetStreamingBudget() const { return m_StreamingBudget; }
+    
+    // Meshing
+    void SetMeshingMode(MeshingMode mode);
+    MeshingMode GetMeshingMode() const { return m_MeshingMode; }
+    const MeshingStats& GetMeshingStats(MeshingMode mode) const { return m_MeshingStats[static_cast<int>(mode)]; }
+    void ResetMeshingStats();
+    void CompareMeshingModes(MeshingMode reference, MeshingMode candidate);
+    const MesherComparison& GetMesherComparison() const { return m_MesherComparison; }
     
     // Settings
     void SetRenderDistance(int distance) { m_RenderDistance = distance; }
     int GetRenderDistance() const { return m_RenderDistance; }
+    void SetVerticalRenderDistance(int distance) { m_VerticalRenderDistance = distance; }
+    int GetVerticalRenderDistance() const { return m_VerticalRenderDistance; }
+    void SetStreamingShape(StreamingShape shape) { m_StreamingShape = shape; }
+    StreamingShape GetStreamingShape() const { return m_StreamingShape; }
+    size_t GetStreamingVolumeSize() const { return m_StreamingVolume.GetLoadOffsets().size(); }
+    
+    // Surface band bias: chunks whose whole layer is sky or stone in an already generated
+    // column are streamed after the chunks that carry the terrain surface
+    void SetSurfaceBandBias(bool enabled) { m_SurfaceBandBias = enabled; }
+    bool GetSurfaceBandBias() const { return m_SurfaceBandBias; }
+    
+    // Predictive prefetch: chunks along the player's predicted path and in view are streamed
+    // before those behind; the trajectory is the smoothed velocity extrapolated by the lookahead
+    void SetPredictivePrefetch(bool enabled) { m_PredictivePrefetch = enabled; }
+    bool GetPredictivePrefetch() const { return m_PredictivePrefetch; }
+    const float3& GetPlayerVelocity() const { return m_PlayerVelocity; }
+    const float3& GetPrefetchOffset() const { return m_PrefetchOffset; }
 
 private:
-    // Chunk storage
-    std::unordered_map<int64_t, std::unique_ptr<Chunk>> m_Chunks;
+    // Recycled chunk objects and their mesh buffers; declared first so they outlive every chunk
+    // handed out from them
+    MeshBufferPool m_MeshBuffers;
+    ChunkPool m_ChunkPool;
     
-    // Chunk generation queue system
-    std::queue<ChunkCoordinate> m_ChunkGenerationQueue;
-    std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> m_QueuedChunks;
+    // Terrain source and column cache shared with the workers, and what generating with them has cost
+    WorldGenerator m_Generator;
+    TerrainColumnCache m_ColumnCache;
+    ChunkMap<SurfaceBand> m_SurfaceBands;           // Per column (chunk Y 0) in the unload radius, for load priorities
+    std::vector<int64_t> m_StaleSurfaceBands;       // PruneSurfaceBands scratch
+    GenerationStats m_GenerationStats;
+    GenerationBenchmark m_GenerationBenchmark;
     
-    // Chunk deletion queue system
-    std::queue<ChunkCoordinate> m_ChunkDeletionQueue;
-    std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> m_QueuedForDeletion;
+    // Chunk storage: handles in a flat index, looked up on every cross-chunk block access
+    ChunkMap<ChunkPtr> m_Chunks;
+    ChunkLookupBenchmark m_ChunkLookupBenchmark;
+    
+    // Streaming volume around the player and the persistent load queue fed from its shell deltas
+    StreamingVolume m_StreamingVolume;
+    ChunkPriorityQueue m_LoadQueue;
+    
+    // Chunks waiting for a remesh (those whose neighbors are ready are also in m_ReadyToMesh),
+    // and lifecycle events not yet drained by the renderer
+    ChunkSet m_DirtyChunks;
+    ChunkQueue m_ReadyToMesh;
+    size_t m_BoundaryRemeshCount = 0;
+    std::vector<ChunkEvent> m_ChunkEvents;
+    StreamingBudget m_StreamingBudget;
+    
+    // Worker threads and the chunks currently handed to them
+    std::unique_ptr<ChunkWorkerPool> m_WorkerPool;
+    ChunkSet m_InFlightChunks;
+    std::vector<ChunkJobResult> m_CompletedJobs;
+    std::vector<ChunkMeshJobPtr> m_CompletedMeshJobs;
+    size_t m_MeshJobsInFlight = 0;
+    
+    // Chunk deletion queue system, and where deleted chunks wait in case they are needed again
+    UnloadedChunkCache m_UnloadedCache;
+    ChunkQueue m_ChunkDeletionQueue;
+    ChunkSet m_QueuedForDeletion;
     
     int m_LastPlayerChunkX = INT_MAX;
     int m_LastPlayerChunkY = INT_MAX; 
@@ -94,9 +245,46 @@ private:
     
     // World settings
     int m_RenderDistance = 16;  // Reduced default for better performance
+    int m_VerticalRenderDistance = 8;
+    StreamingShape m_StreamingShape = StreamingShape::Cylinder;
+    bool m_SurfaceBandBias = true;
+    bool m_PredictivePrefetch = true;
+    MeshingMode m_MeshingMode = MeshingMode::Greedy;
+    MeshingStats m_MeshingStats[static_cast<int>(MeshingMode::Count)];
+    MesherComparison m_MesherComparison;
+    ChunkSnapshot m_MeshSnapshot;   // Mesher input of the meshing comparison
+    size_t m_HeapAllocationsLastFrame = 0;
     float3 m_LastPlayerPosition;
     
+    // Motion behind the prefetch: smoothed velocity (blocks/s), view direction, the predicted
+    // trajectory end relative to the player's chunk (in chunks), and the rounded trajectory and
+    // heading the load queue was last prioritized for
+    float3 m_PreviousPosition;
+    bool m_HasPreviousPosition = false;
+    float3 m_PlayerVelocity;
+    float3 m_ViewDirection;
+    float3 m_PrefetchOffset;
+    int m_PrefetchKey[6] = {};
+    size_t m_CancelledJobCount = 0;
+    std::vector<ChunkCoordinate> m_StaleJobs;       // CancelStaleJobs scratch
+    std::vector<ChunkCoordinate> m_CancelledJobs;
+    
     // Helper methods
     int64_t GetChunkKey(int chunkX, int chunkY, int chunkZ) const;
+    void StreamShellDelta(int directionX, int directionY, int directionZ);
+    void OnChunkArrived(const ChunkCoordinate& coord);
+    bool AreNeighborsReady(const ChunkCoordinate& coord) const;
+    void QueueMeshIfReady(const ChunkCoordinate& coord);
+    void QueueReadyNeighbors(const ChunkCoordinate& coord);
+    float GetChunkPriority(const ChunkCoordinate& coord) const;
+    bool UpdatePrefetch(const float3& playerPosition, const float3& viewDirection, double frameTimeMs);
+    void CancelStaleJobs();
+    void PruneSurfaceBands();
+    bool IsBeyondDeletionDistance(const ChunkCoordinate& coord) const;
+    void FillChunkSnapshot(const Chunk& chunk, ChunkSnapshot& snapshot) const;
+    void SubmitChunkMesh(const ChunkCoordinate& coord, Chunk& chunk);
+    void IntegrateMeshJobs();
+    bool ApplyMeshJob(const ChunkMeshJob& job);
+    void RecordMeshBuild(MeshingMode mode, double buildTimeMs, const Chunk& chunk);
     void GetChunkCoordinates(int worldX, int worldY, int worldZ, int& chunkX, int& chunkY, int& chunkZ, int& localX, int& localY, int& localZ) const;
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "WorldGenerator.h"
+#include <algorithm>
+#include <cmath>
+
+// Terrain shape. Frequencies are in cycles per block.
+static constexpr float s_WarpFrequency = 1.0f / 128.0f;
+static constexpr float s_WarpAmplitude = 24.0f;
+static constexpr float s_BaseFrequency = 1.0f / 256.0f;
+static constexpr float s_BaseHeight = 4.0f;
+static constexpr float s_HillAmplitude = 16.0f;
+static constexpr float s_RidgeFrequency = 1.0f / 384.0f;
+static constexpr float s_MountainFrequency = 1.0f / 1024.0f;
+static constexpr float s_MountainAmplitude = 64.0f;
+
+// SplitMix64 finalizer, used to derive independent per-layer seeds from the world seed
+static uint32_t DeriveSeed(uint64_t seed, uint64_t layer)
+{
+    uint64_t z = seed + (layer + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return static_cast<uint32_t>(z);
+}
+
+WorldGenerator::WorldGenerator(uint64_t seed, NoiseKernel kernel)
+    : m_Seed(seed), m_Kernel(kernel),
+      m_WarpXSeed(DeriveSeed(seed, 0)), m_WarpZSeed(DeriveSeed(seed, 1)), m_BaseSeed(DeriveSeed(seed, 2)),
+      m_RidgeSeed(DeriveSeed(seed, 3)), m_MountainSeed(DeriveSeed(seed, 4))
+{
+}
+
+void WorldGenerator::GenerateColumn(int chunkX, int chunkZ, TerrainColumn& outColumn) const
+{
+    float xs[TERRAIN_COLUMN_SIZE];
+    float zs[TERRAIN_COLUMN_SIZE];
+    for (int z = 0; z < CHUNK_Z_SIZE; ++z)
+    {
+        for (int x = 0; x < CHUNK_X_SIZE; ++x)
+        {
+            xs[z * CHUNK_X_SIZE + x] = static_cast<float>(chunkX * CHUNK_X_SIZE + x);
+            zs[z * CHUNK_X_SIZE + x] = static_cast<float>(chunkZ * CHUNK_Z_SIZE + z);
+        }
+    }
+
+    float mountainMask[TERRAIN_COLUMN_SIZE];
+    EvaluateHeights(xs, zs, TERRAIN_COLUMN_SIZE, outColumn.Heights, mountainMask);
+
+    // Columns at or just above the sea get sand instead of grass and dirt
+    for (int i = 0; i < TERRAIN_COLUMN_SIZE; ++i)
+    {
+        const int height = outColumn.Heights[i];
+        const bool beach = height <= SeaLevel + 1;
+        outColumn.SurfaceBlock[i] = beach ? BlockType::Sand : BlockType::Grass;
+        outColumn.SoilBlock[i] = beach ? BlockType::Sand : BlockType::Dirt;
+
+        if (height < SeaLevel)
+            outColumn.Biomes[i] = Biome::Ocean;
+        else if (beach)
+            outColumn.Biomes[i] = Biome::Beach;
+        else if (mountainMask[i] > 0.5f)
+            outColumn.Biomes[i] = Biome::Mountains;
+        else
+            outColumn.Biomes[i] = Biome::Plains;
+    }
+
+    const auto [minHeight, maxHeight] = std::minmax_element(outColumn.Heights, outColumn.Heights + TERRAIN_COLUMN_SIZE);
+    outColumn.MinHeight = *minHeight;
+    outColumn.MaxHeight = *maxHeight;
+}
+
+int WorldGenerator::GetSurfaceHeight(int worldX, int worldZ) const
+{
+    float x = static_cast<float>(worldX);
+    float z = static_cast<float>(worldZ);
+    int height;
+    float mountainMask;
+    EvaluateHeights(&x, &z, 1, &height, &mountainMask);
+    return height;
+}
+
+void WorldGenerator::EvaluateHeights(const float* xs, const float* zs, int count, int* outHeights, float* outMountainMask) const
+{
+    float warpX[TERRAIN_COLUMN_SIZE];
+    float warpZ[TERRAIN_COLUMN_SIZE];
+    float base[TERRAIN_COLUMN_SIZE];
+    float ridge[TERRAIN_COLUMN_SIZE];
+    float mountain[TERRAIN_COLUMN_SIZE];
+
+    // Domain warp: bend the sample positions so the hills don't line up with the noise lattice
+    Noise::Fbm2DBatch(xs, zs, warpX, count, m_WarpXSeed, 2, s_WarpFrequency, m_Kernel);
+    Noise::Fbm2DBatch(xs, zs, warpZ, count, m_WarpZSeed, 2, s_WarpFrequency, m_Kernel);
+    for (int i = 0; i < count; ++i)
+    {
+        warpX[i] = xs[i] + warpX[i] * s_WarpAmplitude;
+        warpZ[i] = zs[i] + warpZ[i] * s_WarpAmplitude;
+    }
+
+    // Rolling hills everywhere, ridged mountains where the low-frequency mask allows them
+    Noise::Fbm2DBatch(warpX, warpZ, base, count, m_BaseSeed, 5, s_BaseFrequency, m_Kernel);
+    Noise::Ridged2DBatch(warpX, warpZ, ridge, count, m_RidgeSeed, 4, s_RidgeFrequency, m_Kernel);
+    Noise::Fbm2DBatch(xs, zs, mountain, count, m_MountainSeed, 2, s_MountainFrequency, m_Kernel);
+
+    for (int i = 0; i < count; ++i)
+    {
+        float mask = std::min(std::max(mountain[i] * 2.5f, 0.0f), 1.0f);
+        mask = (mask * mask) * (3.0f - 2.0f * mask);
+        float height = s_BaseHeight + base[i] * s_HillAmplitude + (ridge[i] * mask) * s_MountainAmplitude;
+        outHeights[i] = static_cast<int>(std::floor(height));
+        outMountainMask[i] = mask;
+    }
+}
+
+ChunkContents WorldGenerator::ClassifyChunk(int chunkY, const TerrainColumn& column)
+{
+    const int bottom = chunkY * CHUNK_Y_SIZE;
+    const int top = bottom + CHUNK_Y_SIZE - 1;
+
+    if (bottom > std::max(column.MaxHeight, SeaLevel))
+        return ChunkContents::UniformAir;
+    if (top <= column.MinHeight - SoilDepth)
+        return ChunkContents::UniformSolid;
+    return ChunkContents::Mixed;
+}
+
+SurfaceBand WorldGenerator::GetSurfaceBand(const TerrainColumn& column)
+{
+    // Lowest and highest chunk Y that ClassifyChunk reports as Mixed
+    const auto floorDiv = [](int value, int divisor) { return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor); };
+    SurfaceBand band;
+    band.Bottom = floorDiv(column.MinHeight - SoilDepth + 1, CHUNK_Y_SIZE);
+    band.Top = floorDiv(std::max(column.MaxHeight, SeaLevel), CHUNK_Y_SIZE);
+    return band;
+}
+
+int WorldGenerator::GetSurfaceBandDistance(int chunkY, const SurfaceBand& band)
+{
+    if (chunkY > band.Top)
+        return chunkY - band.Top;
+    if (chunkY < band.Bottom)
+        return band.Bottom - chunkY;
+    return 0;
+}
+
+ChunkContents WorldGenerator::GenerateBlocks(int chunkY, const TerrainColumn& column, BlockType* outBlocks)
+{
+    ChunkContents contents = ClassifyChunk(chunkY, column);
+    if (contents != ChunkContents::Mixed)
+        return contents;
+
+    // Strata per column: surface block, soil down to SoilDepth, stone below; water up to sea level
+    const int bottom = chunkY * CHUNK_Y_SIZE;
+    for (int y = 0; y < CHUNK_Y_SIZE; ++y)
+    {
+        const int worldY = bottom + y;
+        for (int z = 0; z < CHUNK_Z_SIZE; ++z)
+        {
+            for (int x = 0; x < CHUNK_X_SIZE; ++x)
+            {
+                const int columnIndex = z * CHUNK_X_SIZE + x;
+                const int depth = column.Heights[columnIndex] - worldY;
+
+                BlockType type;
+                if (depth < 0)
+                    type = worldY <= SeaLevel ? BlockType::Water : BlockType::Air;
+                else if (depth == 0)
+                    type = column.SurfaceBlock[columnIndex];
+                else if (depth < SoilDepth)
+                    type = column.SoilBlock[columnIndex];
+                else
+                    type = BlockType::Stone;
+
+                outBlocks[ChunkBlockIndex(x, y, z)] = type;
+            }
+        }
+    }
+    return ChunkContents::Mixed;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Chunk.h"
+#include "Noise.h"
+#include <cstdint>
+
+// Worldgen version (semver). Bump whenever the output for a given seed changes,
+// so saved worlds can tell which generator produced them.
+struct WorldGenVersion
+{
+    uint16_t Major;
+    uint16_t Minor;
+    uint16_t Patch;
+};
+
+// Coarse climate/terrain class of a column, derived from its height and the mountain mask
+enum class Biome : uint8_t
+{
+    Ocean = 0,
+    Beach,
+    Plains,
+    Mountains,
+    Count
+};
+
+constexpr int TERRAIN_COLUMN_SIZE = CHUNK_X_SIZE * CHUNK_Z_SIZE;
+
+// 2D terrain data for one chunk column (all chunks sharing a chunk X/Z), indexed [z * CHUNK_X_SIZE + x].
+// Everything GenerateBlocks needs, so the stack of chunks above and below reuses one noise evaluation.
+struct TerrainColumn
+{
+    int Heights[TERRAIN_COLUMN_SIZE];           // World Y of the topmost solid block
+    BlockType SurfaceBlock[TERRAIN_COLUMN_SIZE];
+    BlockType SoilBlock[TERRAIN_COLUMN_SIZE];   // Fills the SoilDepth - 1 blocks under the surface
+    Biome Biomes[TERRAIN_COLUMN_SIZE];
+    int MinHeight;
+    int MaxHeight;
+};
+
+// Chunk Y range of a column's Mixed chunks (see WorldGenerator::ClassifyChunk)
+struct SurfaceBand
+{
+    int Bottom = 0;
+    int Top = 0;
+};
+
+// Deterministic terrain from a 64-bit seed: a domain-warped FBM heightfield with ridged
+// mountains, layered into grass/sand, dirt and stone strata over a flat sea.
+// Columns are evaluated 16x16 at a time with the batched noise kernels and turned into chunks
+// without further noise. All methods are const, so one generator is shared by every worker thread.
+class WorldGenerator
+{
+public:
+    static constexpr uint64_t DefaultSeed = 0x466F726765644Full;
+    static constexpr WorldGenVersion Version = { 0, 1, 0 };
+    static constexpr int SeaLevel = 0;      // Highest world Y filled with water
+    static constexpr int SoilDepth = 4;     // Surface block plus the dirt/sand beneath it
+
+    explicit WorldGenerator(uint64_t seed = DefaultSeed, NoiseKernel kernel = NoiseKernel::Simd);
+
+    uint64_t GetSeed() const { return m_Seed; }
+    NoiseKernel GetKernel() const { return m_Kernel; }
+
+    void GenerateColumn(int chunkX, int chunkZ, TerrainColumn& outColumn) const;
+    int GetSurfaceHeight(int worldX, int worldZ) const;
+
+    // Whole-chunk classification from the column alone: UniformAir above the terrain and sea,
+    // UniformSolid inside the stone, Mixed otherwise
+    static ChunkContents ClassifyChunk(int chunkY, const TerrainColumn& column);
+
+    static SurfaceBand GetSurfaceBand(const TerrainColumn& column);
+
+    // Chunk layers between chunkY and a column's Mixed chunks (0 inside that band)
+    static int GetSurfaceBandDistance(int chunkY, const SurfaceBand& band);
+
+    // Fills one chunk of a column in ChunkBlockIndex order. Uniform chunks (see ClassifyChunk)
+    // are returned without touching outBlocks; Mixed means outBlocks was written.
+    static ChunkContents GenerateBlocks(int chunkY, const TerrainColumn& column, BlockType* outBlocks);
+
+private:
+    uint64_t m_Seed;
+    NoiseKernel m_Kernel;
+
+    // Per-layer noise seeds derived from the world seed
+    uint32_t m_WarpXSeed;
+    uint32_t m_WarpZSeed;
+    uint32_t m_BaseSeed;
+    uint32_t m_RidgeSeed;
+    uint32_t m_MountainSeed;
+
+    void EvaluateHeights(const float* xs, const float* zs, int count, int* outHeights, float* outMountainMask) const;
+};